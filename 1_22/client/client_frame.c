@@ -0,0 +1,184 @@
+#include "client_function.h"
+
+static uint32_t crc_table[256];
+static int crc_table_ready = 0;
+
+static uint32_t
+client_crc32c(const uint8_t *data, size_t len)
+{
+    if (!crc_table_ready)                                                           // 클라이언트는 검증용이므로 바이트 단위 테이블로 충분
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++)
+                crc = (crc & 1) ? (crc >> 1) ^ 0x82F63B78u : crc >> 1;
+            crc_table[i] = crc;
+        }
+        crc_table_ready = 1;
+    }
+    uint32_t crc = 0xFFFFFFFFu;
+    while (len--)
+        crc = crc_table[(crc ^ *data++) & 0xff] ^ (crc >> 8);
+    return ~crc;
+}
+static void
+put_be32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+static uint32_t
+get_be32(const uint8_t *p)
+{
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | (uint32_t)p[3];
+}
+long
+client_frame_build(uint8_t *out, size_t cap, uint8_t type, uint8_t flags, const void *payload, uint32_t len)
+{
+    size_t total = FRAME_HEADER_SIZE + len + ((flags & FRAME_FLAG_CRC) ? FRAME_CRC_SIZE : 0);
+    if (total > cap)
+        return -1;
+    out[0] = FRAME_MAGIC;
+    out[1] = type;
+    out[2] = flags;
+    out[3] = 0;
+    put_be32(out + 4, len);
+    if (payload != out + FRAME_HEADER_SIZE)
+        memcpy(out + FRAME_HEADER_SIZE, payload, len);
+    if (flags & FRAME_FLAG_CRC)
+        put_be32(out + FRAME_HEADER_SIZE + len, client_crc32c(out, FRAME_HEADER_SIZE + len));
+    return (long)total;
+}
+long
+client_frame_parse(const uint8_t *buf, size_t len, uint8_t *flags, uint32_t *payload_len)
+{
+    if (len < FRAME_HEADER_SIZE)
+        return 0;
+    if (buf[0] != FRAME_MAGIC)
+        return -1;
+    *flags = buf[2];
+    *payload_len = get_be32(buf + 4);
+    size_t total = FRAME_HEADER_SIZE + *payload_len + ((*flags & FRAME_FLAG_CRC) ? FRAME_CRC_SIZE : 0);
+    if (*payload_len > FRAME_MAX_PAYLOAD)
+        return -1;
+    if (len < total)
+        return 0;
+    if ((*flags & FRAME_FLAG_CRC) && client_crc32c(buf, FRAME_HEADER_SIZE + *payload_len) != get_be32(buf + FRAME_HEADER_SIZE + *payload_len))
+        return -2;                                                                  // 서버 응답 손상
+    return (long)total;
+}
+int
+client_frame_recv(struct ssl_st *ssl, int sock, uint8_t *buf, size_t *len, size_t cap, int client_id)
+{
+    uint8_t flags;
+    uint32_t payload_len;
+    for (;;)                                                                        // 프레임 하나가 완성될 때까지 추가 수신
+    {
+        long frame_len = client_frame_parse(buf, *len, &flags, &payload_len);
+        if (frame_len > 0)
+            return (int)payload_len;
+        if (frame_len == -2)
+        {
+            fprintf(stderr, "client_frame_recv() : [클라이언트 #%d] CRC32C 불일치\n", client_id);
+            return -1;
+        }
+        if (frame_len < 0 || *len >= cap)
+        {
+            fprintf(stderr, "client_frame_recv() : [클라이언트 #%d] 잘못된 프레임\n", client_id);
+            return -1;
+        }
+        struct pollfd pfd = {.fd = sock, .events = POLLIN, .revents = 0};
+        if (poll(&pfd, 1, POLL_TIMEOUT) <= 0)
+        {
+            if (errno == EINTR)
+                continue;
+            fprintf(stderr, "client_frame_recv() : [클라이언트 #%d] 응답 대기 실패\n", client_id);
+            return -1;
+        }
+        ssize_t n = client_read(ssl, sock, buf + *len, cap - *len);
+        if (n == 0)
+            return -1;
+        if (n < 0)
+        {
+            if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)
+                continue;
+            return -1;
+        }
+        *len += (size_t)n;
+    }
+}
+static double
+client_elapsed_ms(const struct timespec *t0)
+{
+    struct timespec t1;
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    return (t1.tv_sec - t0->tv_sec) * 1000.0 + (t1.tv_nsec - t0->tv_nsec) / 1e6;
+}
+long
+client_frame_encode(ClientState *state, uint8_t caps, uint8_t type, const void *payload, uint32_t len, uint8_t *out, size_t cap)
+{
+    uint8_t *body = out + FRAME_HEADER_SIZE;
+    long total;
+    state->raw_out += len;
+    if (type == FRAME_TYPE_DATA && (caps & FRAME_CAP_LZ4) && len >= LZ4_MIN_INPUT && cap >= FRAME_HEADER_SIZE + len + FRAME_CRC_SIZE)
+    {
+        struct timespec t0;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        int comp_len = lz4_compress_block(payload, (int)len, body + FRAME_LZ4_PREFIX, (int)len - FRAME_LZ4_PREFIX - 1);
+        state->compress_ms += client_elapsed_ms(&t0);
+        if (comp_len > 0)                                                           // 압축 이득이 있을 때만 LZ4 프레임
+        {
+            put_be32(body, len);
+            total = client_frame_build(out, cap, type, state->frame_flags | FRAME_FLAG_LZ4, body, (uint32_t)comp_len + FRAME_LZ4_PREFIX);
+            if (total > 0)
+                state->wire_out += (unsigned long)total;
+            return total;
+        }
+    }
+    total = client_frame_build(out, cap, type, state->frame_flags, payload, len);
+    if (total > 0)
+        state->wire_out += (unsigned long)total;
+    return total;
+}
+int
+client_frame_decode(ClientState *state, const uint8_t *frame, uint8_t *out, size_t cap)
+{
+    uint8_t flags = frame[2];
+    uint32_t len = get_be32(frame + 4);
+    const uint8_t *payload = frame + FRAME_HEADER_SIZE;
+    state->wire_in += FRAME_HEADER_SIZE + len + ((flags & FRAME_FLAG_CRC) ? FRAME_CRC_SIZE : 0);
+    if (!(flags & FRAME_FLAG_LZ4))
+    {
+        if (len > cap)
+            return -1;
+        memcpy(out, payload, len);
+        state->raw_in += len;
+        return (int)len;
+    }
+    if (len <= FRAME_LZ4_PREFIX)
+        return -1;
+    struct timespec t0;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    int raw_len = lz4_decompress_block(payload + FRAME_LZ4_PREFIX, (int)(len - FRAME_LZ4_PREFIX), out, (int)cap);
+    state->decompress_ms += client_elapsed_ms(&t0);
+    if (raw_len < 0 || (uint32_t)raw_len != get_be32(payload))
+        return -1;
+    state->raw_in += (unsigned long)raw_len;
+    return raw_len;
+}
+void
+client_frame_print_stats(ClientState *state)
+{
+    if (!state->framed)
+        return;
+    printf("[프레임] 송신 wire %lu / raw %lu bytes (%.1f%%), 수신 wire %lu / raw %lu bytes (%.1f%%)\n",
+           state->wire_out, state->raw_out, state->raw_out ? 100.0 * state->wire_out / state->raw_out : 0.0,
+           state->wire_in, state->raw_in, state->raw_in ? 100.0 * state->wire_in / state->raw_in : 0.0);
+    if (state->frame_caps & FRAME_CAP_LZ4)
+        printf("[LZ4] 압축 %.2f ms/MB, 해제 %.2f ms/MB\n",
+               state->raw_out ? state->compress_ms * 1048576.0 / state->raw_out : 0.0,
+               state->raw_in ? state->decompress_ms * 1048576.0 / state->raw_in : 0.0);
+}
@@ -12,19 +12,87 @@
 #include <errno.h>
 #include <time.h>
 #include <poll.h>
+#include <stdint.h>
+#include "lz4_block.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
 #define BUF_SIZE 1024
 #define IO_COUNT 10
 #define POLL_TIMEOUT 10000
+#define TLS_CA_FILE "server.crt"
+#define RTT_MAX_SAMPLES 1000000
+#define FRAME_MAGIC 0xFE
+#define FRAME_HEADER_SIZE 8
+#define FRAME_CRC_SIZE 4
+#define FRAME_MAX_PAYLOAD 16384
+#define FRAME_BUF_SIZE (FRAME_HEADER_SIZE + FRAME_MAX_PAYLOAD + FRAME_CRC_SIZE)
+#define FRAME_TYPE_DATA 1
+#define FRAME_TYPE_HELLO 2
+#define FRAME_FLAG_CRC 0x01
+#define FRAME_FLAG_LZ4 0x02
+#define FRAME_CAP_LZ4 0x01
+#define FRAME_LZ4_PREFIX 4
+#define FRAME_CAP_RESUME 0x02
+#define FRAME_TYPE_SUBSCRIBE 3
+#define FRAME_TYPE_PUBLISH 5
+#define FRAME_TYPE_MESSAGE 6
+#define PUBSUB_TOPIC_MAX 32
+#define PUBSUB_MSG_MAX 1024
+#define PUBSUB_MODE_NONE 0
+#define PUBSUB_MODE_SUBSCRIBE 1
+#define PUBSUB_MODE_PUBLISH 2
+struct ssl_st;
+struct ssl_ctx_st;
+struct ssl_session_st;
 typedef struct 
 {
     volatile sig_atomic_t running;
+    struct ssl_ctx_st *tls_ctx;
+    struct ssl_session_st *tls_session;
+    int tls_handshakes;
+    int tls_resumed;
+    double tls_handshake_ms;
+    int framed;
+    uint8_t frame_flags;
+    uint8_t frame_caps;
+    uint64_t resume_token;
+    int resumed_count;
+    int batch;
+    unsigned long wire_out;
+    unsigned long raw_out;
+    unsigned long wire_in;
+    unsigned long raw_in;
+    double compress_ms;
+    double decompress_ms;
+    double *rtt_us;
+    size_t rtt_count;
+    int pubsub_mode;
+    char pubsub_topic[PUBSUB_TOPIC_MAX];
+    unsigned long pub_count;
+    unsigned long pub_fanout;
+    double pub_ms;
+    unsigned long sub_received;
 } ClientState;
 extern void         client_run(const char *ip, int port, int client_id, ClientState *state);
 extern int          client_connect(int argc, char *argv[]);
 extern void         setup_client_signal_handlers(ClientState *state);
+extern int          client_tls_init(ClientState *state);
+extern void         client_tls_cleanup(ClientState *state);
+extern int          client_tls_connect(ClientState *state, int sock, int client_id, struct ssl_st **out);
+extern void         client_tls_close(ClientState *state, struct ssl_st *ssl);
+extern ssize_t      client_read(struct ssl_st *ssl, int sock, void *buf, size_t len);
+extern ssize_t      client_write(struct ssl_st *ssl, int sock, const void *buf, size_t len);
+extern long         client_frame_build(uint8_t *out, size_t cap, uint8_t type, uint8_t flags, const void *payload, uint32_t len);
+extern long         client_frame_parse(const uint8_t *buf, size_t len, uint8_t *flags, uint32_t *payload_len);
+extern int          client_frame_recv(struct ssl_st *ssl, int sock, uint8_t *buf, size_t *len, size_t cap, int client_id);
+extern long         client_frame_encode(ClientState *state, uint8_t caps, uint8_t type, const void *payload, uint32_t len, uint8_t *out, size_t cap);
+extern int          client_frame_decode(ClientState *state, const uint8_t *frame, uint8_t *out, size_t cap);
+extern void         client_frame_print_stats(ClientState *state);
+extern void         client_rtt_record(ClientState *state, const struct timespec *t0);
+extern void         client_rtt_report(ClientState *state);
+extern int          client_pubsub_session(ClientState *state, struct ssl_st *ssl, int sock, int client_id, uint8_t caps);
+extern void         client_pubsub_report(ClientState *state);
 #ifdef __cplusplus
 }
 #endif
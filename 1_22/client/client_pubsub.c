@@ -0,0 +1,161 @@
+#include "client_function.h"
+
+static size_t
+client_frame_size(const uint8_t *buf)
+{
+    size_t len = (size_t)buf[4] << 24 | (size_t)buf[5] << 16 | (size_t)buf[6] << 8 | buf[7];
+    return FRAME_HEADER_SIZE + len + ((buf[2] & FRAME_FLAG_CRC) ? FRAME_CRC_SIZE : 0);
+}
+static int
+client_write_all(struct ssl_st *ssl, int sock, const uint8_t *buf, size_t len, ClientState *state)
+{
+    size_t sent = 0;
+    while (sent < len && state->running)
+    {
+        ssize_t n = client_write(ssl, sock, buf + sent, len - sent);
+        if (n == -1)
+        {
+            if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)
+                continue;
+            return -1;
+        }
+        sent += (size_t)n;
+    }
+    return sent < len ? -1 : 0;
+}
+static int
+client_pubsub_request(ClientState *state, struct ssl_st *ssl, int sock, int client_id, uint8_t caps, uint8_t type,
+                      const uint8_t *payload, uint32_t len, uint8_t *recv_buf, size_t *recv_len, uint32_t *status)
+{
+    uint8_t frame_buf[FRAME_BUF_SIZE];
+    uint8_t reply[FRAME_MAX_PAYLOAD];
+    long frame_len = client_frame_encode(state, caps, type, payload, len, frame_buf, sizeof(frame_buf));
+    if (frame_len < 0 || client_write_all(ssl, sock, frame_buf, (size_t)frame_len, state) == -1)
+        return -1;
+    for (;;)                                                                        // 응답 프레임([상태 4바이트])이 올 때까지 수신
+    {
+        if (client_frame_recv(ssl, sock, recv_buf, recv_len, FRAME_BUF_SIZE, client_id) < 0)
+            return -1;
+        size_t consumed = client_frame_size(recv_buf);
+        uint8_t reply_type = recv_buf[1];
+        int reply_len = client_frame_decode(state, recv_buf, reply, sizeof(reply));
+        memmove(recv_buf, recv_buf + consumed, *recv_len - consumed);
+        *recv_len -= consumed;
+        if (reply_type != type)
+            continue;
+        if (reply_len < 4)
+            return -1;
+        *status = (uint32_t)reply[0] << 24 | (uint32_t)reply[1] << 16 | (uint32_t)reply[2] << 8 | reply[3];
+        return *status == UINT32_MAX ? -1 : 0;
+    }
+}
+static int
+client_publish_loop(ClientState *state, struct ssl_st *ssl, int sock, int client_id, uint8_t caps)
+{
+    uint8_t recv_buf[FRAME_BUF_SIZE];
+    uint8_t payload[PUBSUB_MSG_MAX];
+    size_t recv_len = 0;
+    size_t topic_len = strlen(state->pubsub_topic);
+    int count = 0;
+    payload[0] = (uint8_t)topic_len;                                                // [토픽 길이][토픽][본문]
+    memcpy(payload + 1, state->pubsub_topic, topic_len);
+    while (count < IO_COUNT * state->batch && state->running)
+    {
+        int body_len = snprintf((char *)payload + 1 + topic_len, sizeof(payload) - 1 - topic_len,
+                                "[Publisher #%d] Message #%d at %ld\n", client_id, count + 1, time(NULL));
+        uint32_t fanout;
+        struct timespec t0;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        if (client_pubsub_request(state, ssl, sock, client_id, caps, FRAME_TYPE_PUBLISH, payload, (uint32_t)(1 + topic_len + body_len), recv_buf, &recv_len, &fanout) == -1)
+        {
+            fprintf(stderr, "client_publish_loop() : [클라이언트 #%d] 발행 실패\n", client_id);
+            return -1;
+        }
+        client_rtt_record(state, &t0);
+        struct timespec t1;
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        state->pub_ms += (t1.tv_sec - t0.tv_sec) * 1000.0 + (t1.tv_nsec - t0.tv_nsec) / 1e6;
+        state->pub_count++;
+        state->pub_fanout += fanout;
+        count++;
+        printf("[클라이언트 #%d] 발행 #%d → 구독자 %u명\n", client_id, count, fanout);
+    }
+    return count;
+}
+static int
+client_subscribe_loop(ClientState *state, struct ssl_st *ssl, int sock, int client_id, uint8_t caps)
+{
+    uint8_t recv_buf[FRAME_BUF_SIZE];
+    uint8_t message[FRAME_MAX_PAYLOAD + 1];
+    size_t recv_len = 0;
+    uint32_t status;
+    if (client_pubsub_request(state, ssl, sock, client_id, caps, FRAME_TYPE_SUBSCRIBE, (const uint8_t *)state->pubsub_topic,
+                              (uint32_t)strlen(state->pubsub_topic), recv_buf, &recv_len, &status) == -1)
+    {
+        fprintf(stderr, "client_subscribe_loop() : [클라이언트 #%d] 구독 실패\n", client_id);
+        return -1;
+    }
+    printf("[클라이언트 #%d] 구독 시작: '%s'\n", client_id, state->pubsub_topic);
+    while (state->running)
+    {
+        uint8_t flags;
+        uint32_t payload_len;
+        long frame_len = client_frame_parse(recv_buf, recv_len, &flags, &payload_len);
+        if (frame_len < 0)
+        {
+            fprintf(stderr, "client_subscribe_loop() : [클라이언트 #%d] 잘못된 프레임\n", client_id);
+            return -1;
+        }
+        if (frame_len > 0)                                                          // 완성된 메시지 프레임 처리
+        {
+            uint8_t type = recv_buf[1];
+            int len = client_frame_decode(state, recv_buf, message, FRAME_MAX_PAYLOAD);
+            memmove(recv_buf, recv_buf + frame_len, recv_len - (size_t)frame_len);
+            recv_len -= (size_t)frame_len;
+            if (type != FRAME_TYPE_MESSAGE || len < 1 || 1 + message[0] > len)
+                continue;
+            state->sub_received++;
+            message[len] = 0;
+            const char *body = (const char *)message + 1 + message[0];
+            printf("[클라이언트 #%d] 수신 '%.*s': %.*s\n", client_id, message[0], (const char *)message + 1, (int)strcspn(body, "\n"), body);
+            continue;
+        }
+        struct pollfd pfd = {.fd = sock, .events = POLLIN, .revents = 0};
+        int ret = poll(&pfd, 1, POLL_TIMEOUT);                                      // 구독자는 메시지가 올 때까지 대기 (타임아웃은 정상)
+        if (ret == -1 && errno != EINTR)
+            return -1;
+        if (ret <= 0)
+            continue;
+        ssize_t n = client_read(ssl, sock, recv_buf + recv_len, sizeof(recv_buf) - recv_len);
+        if (n == 0)
+        {
+            fprintf(stderr, "client_subscribe_loop() : [클라이언트 #%d] 서버 연결 종료 (EOF)\n", client_id);
+            return -1;
+        }
+        if (n < 0)
+        {
+            if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)
+                continue;
+            return -1;
+        }
+        recv_len += (size_t)n;
+    }
+    return 0;
+}
+int
+client_pubsub_session(ClientState *state, struct ssl_st *ssl, int sock, int client_id, uint8_t caps)
+{
+    if (state->pubsub_mode == PUBSUB_MODE_PUBLISH)
+        return client_publish_loop(state, ssl, sock, client_id, caps);
+    return client_subscribe_loop(state, ssl, sock, client_id, caps);
+}
+void
+client_pubsub_report(ClientState *state)
+{
+    if (state->pubsub_mode == PUBSUB_MODE_PUBLISH && state->pub_count > 0)
+        printf("[pub/sub] 발행 %lu건, 총 전달 %lu건 (평균 fanout %.1f), 발행 %.0f건/s, 전달 %.0f건/s\n",
+               state->pub_count, state->pub_fanout, (double)state->pub_fanout / state->pub_count,
+               state->pub_count * 1000.0 / state->pub_ms, state->pub_fanout * 1000.0 / state->pub_ms);
+    else if (state->pubsub_mode == PUBSUB_MODE_SUBSCRIBE)
+        printf("[pub/sub] '%s' 수신 %lu건\n", state->pubsub_topic, state->sub_received);
+}
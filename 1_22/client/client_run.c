@@ -4,7 +4,10 @@ client_run(const char *ip, int port, int client_id, ClientState *state)
 {
     int sock, count = 0;
     struct sockaddr_in serv_addr;
-    char msg[BUF_SIZE], recv_buf[BUF_SIZE];
+    char msg[BUF_SIZE];
+    uint8_t recv_buf[FRAME_BUF_SIZE + 1], frame_buf[FRAME_BUF_SIZE];          // +1: 최대 크기 프레임 + 텍스트 모드의 NUL
+    char payload[FRAME_MAX_PAYLOAD + 1];
+    uint8_t caps = 0;
     time_t start_time, end_time;
     start_time = time(NULL);
     sock = socket(PF_INET, SOCK_STREAM, 0);
@@ -29,6 +32,69 @@ client_run(const char *ip, int port, int client_id, ClientState *state)
         return;
     }
     printf("[클라이언트 #%d] 서버 연결 성공!\n", client_id);
+    struct ssl_st *ssl = NULL;
+    if (client_tls_connect(state, sock, client_id, &ssl) == -1)
+    {
+        close(sock);
+        return;
+    }
+    if (state->framed && state->frame_caps != 0)                                   // HELLO 프레임으로 기능 협상 (+ 이전 세션 재개)
+    {
+        size_t recv_len = 0;
+        uint8_t hello[9];
+        hello[0] = state->frame_caps;
+        for (int i = 0; i < 8; i++)
+            hello[1 + i] = (uint8_t)(state->resume_token >> (56 - 8 * i));
+        uint32_t hello_size = (state->frame_caps & FRAME_CAP_RESUME) && state->resume_token ? 9 : 1;
+        long hello_len = client_frame_encode(state, 0, FRAME_TYPE_HELLO, hello, hello_size, frame_buf, sizeof(frame_buf));
+        int reply_len = -1;
+        if (hello_len > 0 && client_write(ssl, sock, frame_buf, (size_t)hello_len) == hello_len &&
+            client_frame_recv(ssl, sock, recv_buf, &recv_len, sizeof(recv_buf), client_id) >= 1)
+            reply_len = client_frame_decode(state, recv_buf, (uint8_t *)payload, sizeof(payload));
+        if (reply_len < 1)
+        {
+            fprintf(stderr, "client_run() : [클라이언트 #%d] HELLO 협상 실패\n", client_id);
+            client_tls_close(state, ssl);
+            close(sock);
+            return;
+        }
+        const uint8_t *reply = (const uint8_t *)payload;
+        caps = reply[0] & state->frame_caps;
+        if (reply_len >= 14)                                                        // [caps][토큰 8][재개 여부][io_count 4]
+        {
+            state->resume_token = 0;
+            for (int i = 0; i < 8; i++)
+                state->resume_token = state->resume_token << 8 | reply[1 + i];
+            if (reply[9])
+            {
+                count = (int)((uint32_t)reply[10] << 24 | (uint32_t)reply[11] << 16 | (uint32_t)reply[12] << 8 | reply[13]);
+                state->resumed_count++;
+                printf("[클라이언트 #%d] 세션 재개: %d/%d부터 계속\n", client_id, count, IO_COUNT);
+            }
+        }
+        size_t pending = reply_len >= 18 ? ((size_t)reply[14] << 24 | (size_t)reply[15] << 16 | (size_t)reply[16] << 8 | reply[17]) : 0;
+        size_t consumed = FRAME_HEADER_SIZE + ((size_t)recv_buf[4] << 24 | (size_t)recv_buf[5] << 16 | (size_t)recv_buf[6] << 8 | recv_buf[7]) + ((recv_buf[2] & FRAME_FLAG_CRC) ? FRAME_CRC_SIZE : 0);
+        while (pending > 0)                                                         // 재개된 세션: 끊기기 전 받지 못한 응답 프레임 수신
+        {
+            memmove(recv_buf, recv_buf + consumed, recv_len - consumed);
+            recv_len -= consumed;
+            if (client_frame_recv(ssl, sock, recv_buf, &recv_len, sizeof(recv_buf), client_id) < 0)
+                break;
+            consumed = FRAME_HEADER_SIZE + ((size_t)recv_buf[4] << 24 | (size_t)recv_buf[5] << 16 | (size_t)recv_buf[6] << 8 | recv_buf[7]) + ((recv_buf[2] & FRAME_FLAG_CRC) ? FRAME_CRC_SIZE : 0);
+            int len = client_frame_decode(state, recv_buf, (uint8_t *)payload, FRAME_MAX_PAYLOAD);
+            if (len >= 0)
+                printf("[클라이언트 #%d] 재전송 수신(frame %d bytes): %.*s\n", client_id, len, (int)strcspn(payload, "\n"), payload);
+            pending = consumed < pending ? pending - consumed : 0;
+        }
+        printf("[클라이언트 #%d] 협상 결과: LZ4 %s, 재개 %s\n", client_id, (caps & FRAME_CAP_LZ4) ? "on" : "off", (caps & FRAME_CAP_RESUME) ? "on" : "off");
+    }
+    if (state->pubsub_mode != PUBSUB_MODE_NONE)                                    // 발행/구독 모드: 에코 루프 대신 실행
+    {
+        client_pubsub_session(state, ssl, sock, client_id, caps);
+        client_tls_close(state, ssl);
+        close(sock);
+        return;
+    }
     struct pollfd read_pfd = {.fd = sock, .events = POLLIN, .revents = 0};
     while (count < IO_COUNT && state->running) 
     {
@@ -38,11 +104,25 @@ client_run(const char *ip, int port, int client_id, ClientState *state)
             break;
         }
         snprintf(msg, BUF_SIZE, "[Client #%d] Message #%d at %ld\n", client_id, count + 1, time(NULL));
+        struct timespec rtt_start;
+        clock_gettime(CLOCK_MONOTONIC, &rtt_start);                                     // 전송 직전부터 응답 수신까지 RTT
         ssize_t sent = 0;
-        int msg_len = strlen(msg);
+        const char *out = msg;
+        long msg_len = strlen(msg);
+        if (state->framed)                                                              // 프레임 모드: 헤더(+CRC32C 트레일러)로 감싸서 전송
+        {
+            size_t payload_len = 0;
+            for (int i = 0; i < state->batch && payload_len + msg_len <= FRAME_MAX_PAYLOAD; i++)   // 대량 전송 시나리오: 메시지 여러 줄을 한 프레임에
+            {
+                memcpy(payload + payload_len, msg, (size_t)msg_len);
+                payload_len += (size_t)msg_len;
+            }
+            msg_len = client_frame_encode(state, caps, FRAME_TYPE_DATA, payload, (uint32_t)payload_len, frame_buf, sizeof(frame_buf));
+            out = (const char *)frame_buf;
+        }
         while (sent < msg_len && state->running) 
         {
-            ssize_t write_result = write(sock, msg + sent, msg_len - sent);
+            ssize_t write_result = client_write(ssl, sock, out + sent, msg_len - sent);
             if (write_result == -1) 
             {
                 if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)
@@ -90,11 +170,27 @@ client_run(const char *ip, int port, int client_id, ClientState *state)
         } 
         else if (read_pfd.revents & POLLIN) 
         {
-            ssize_t str_len = read(sock, recv_buf, BUF_SIZE - 1);
-            if (str_len > 0) 
+            ssize_t str_len = client_read(ssl, sock, recv_buf, sizeof(recv_buf) - 1);
+            if (str_len > 0 && state->framed) 
+            {
+                size_t recv_len = (size_t)str_len;
+                if (client_frame_recv(ssl, sock, recv_buf, &recv_len, sizeof(recv_buf) - 1, client_id) < 0)
+                    break;
+                int payload_len = client_frame_decode(state, recv_buf, (uint8_t *)payload, FRAME_MAX_PAYLOAD);
+                if (payload_len < 0)
+                {
+                    fprintf(stderr, "client_run() : [클라이언트 #%d] 프레임 해제 실패\n", client_id);
+                    break;
+                }
+                client_rtt_record(state, &rtt_start);
+                payload[payload_len] = 0;
+                printf("[클라이언트 #%d] 수신(frame %d bytes): %.*s\n", client_id, payload_len, (int)strcspn(payload, "\n"), payload);
+            } 
+            else if (str_len > 0) 
             {
+                client_rtt_record(state, &rtt_start);
                 recv_buf[str_len] = 0;
-                printf("[클라이언트 #%d] 수신: %s", client_id, recv_buf);
+                printf("[클라이언트 #%d] 수신: %s", client_id, (char *)recv_buf);
             } 
             else if (str_len == 0) 
             {
@@ -116,6 +212,7 @@ client_run(const char *ip, int port, int client_id, ClientState *state)
         printf("[클라이언트 #%d] 완료: %d I/O, %ld초\n", client_id, count, end_time - start_time);
     else
         printf("[클라이언트 #%d] 중단: %d/%d I/O, %ld초\n", client_id, count, IO_COUNT, end_time - start_time);
+    client_tls_close(state, ssl);
     close(sock);
 }
 
@@ -145,12 +242,53 @@ client_connect(int argc, char *argv[])
     printf("Ctrl+C로 종료하세요.\n\n");
     ClientState state = {0};
     state.running = 1;
+    const char *frame_mode = getenv("ECHO_FRAME");                                  // 예: ECHO_FRAME=crc
+    if (frame_mode != NULL)
+    {
+        state.framed = 1;
+        if (strstr(frame_mode, "crc"))
+            state.frame_flags |= FRAME_FLAG_CRC;
+        if (strstr(frame_mode, "lz4"))                                              // 예: ECHO_FRAME=crc,lz4,resume
+            state.frame_caps |= FRAME_CAP_LZ4;
+        if (strstr(frame_mode, "resume"))
+            state.frame_caps |= FRAME_CAP_RESUME;
+        state.batch = getenv("ECHO_BATCH") ? atoi(getenv("ECHO_BATCH")) : 1;
+        if (state.batch < 1)
+            state.batch = 1;
+        printf("프레임 모드: %s\n", frame_mode);
+    }
+    const char *pubsub = getenv("ECHO_PUBSUB");                                     // 예: ECHO_PUBSUB=sub:news 또는 pub:news
+    if (pubsub != NULL && (strncmp(pubsub, "sub:", 4) == 0 || strncmp(pubsub, "pub:", 4) == 0) &&
+        pubsub[4] != '\0' && strlen(pubsub + 4) < PUBSUB_TOPIC_MAX)
+    {
+        state.framed = 1;                                                           // 발행/구독은 프레임 모드에서만 동작
+        state.pubsub_mode = pubsub[0] == 's' ? PUBSUB_MODE_SUBSCRIBE : PUBSUB_MODE_PUBLISH;
+        snprintf(state.pubsub_topic, sizeof(state.pubsub_topic), "%s", pubsub + 4);
+        if (state.batch < 1)                                                        // 발행자는 연결당 IO_COUNT * ECHO_BATCH건 발행
+            state.batch = getenv("ECHO_BATCH") ? atoi(getenv("ECHO_BATCH")) : 1;
+        if (state.batch < 1)
+            state.batch = 1;
+        printf("pub/sub 모드: %s\n", pubsub);
+    }
     setup_client_signal_handlers(&state);
+    state.rtt_us = malloc(sizeof(double) * RTT_MAX_SAMPLES);                        // RTT 분포 측정용 (실패해도 에코는 계속)
+    if (client_tls_init(&state) == -1)
+    {
+        fprintf(stderr, "client_connect() : TLS 초기화 실패\n");
+        exit(1);
+    }
     while (state.running) 
     {
         iteration++;
         printf("\n[클라이언트 #%d] ===== 반복 #%d =====\n", client_id, iteration);
         client_run(ip, port, client_id, &state);
     }
+    client_rtt_report(&state);
+    client_pubsub_report(&state);
+    free(state.rtt_us);
+    client_frame_print_stats(&state);
+    if (state.frame_caps & FRAME_CAP_RESUME)
+        printf("[재개] %d회 세션 재개\n", state.resumed_count);
+    client_tls_cleanup(&state);
     return 0;
 }
@@ -0,0 +1,29 @@
+#include "client_function.h"
+
+static int
+rtt_compare(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+void
+client_rtt_record(ClientState *state, const struct timespec *t0)
+{
+    struct timespec t1;
+    if (state->rtt_us == NULL || state->rtt_count >= RTT_MAX_SAMPLES)
+        return;
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    state->rtt_us[state->rtt_count++] = (t1.tv_sec - t0->tv_sec) * 1e6 + (t1.tv_nsec - t0->tv_nsec) / 1e3;
+}
+void
+client_rtt_report(ClientState *state)
+{
+    if (state->rtt_us == NULL || state->rtt_count == 0)
+        return;
+    qsort(state->rtt_us, state->rtt_count, sizeof(double), rtt_compare);       // 종료 시 한 번만 정렬
+    size_t n = state->rtt_count;
+    printf("[RTT] %zu회 에코: p50 %.1f us, p99 %.1f us, p99.9 %.1f us, max %.1f us\n", n,
+           state->rtt_us[(size_t)(n * 0.50)], state->rtt_us[(size_t)(n * 0.99)],
+           state->rtt_us[(size_t)(n * 0.999)], state->rtt_us[n - 1]);
+}
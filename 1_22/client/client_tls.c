@@ -0,0 +1,155 @@
+#include "client_function.h"
+#ifdef USE_TLS
+#include <openssl/ssl.h>
+#include <openssl/err.h>
+
+int
+client_tls_init(ClientState *state)
+{
+    state->tls_ctx = SSL_CTX_new(TLS_client_method());
+    if (state->tls_ctx == NULL)
+    {
+        ERR_print_errors_fp(stderr);
+        return -1;
+    }
+    SSL_CTX_set_min_proto_version(state->tls_ctx, TLS1_2_VERSION);
+    SSL_CTX_set_session_cache_mode(state->tls_ctx, SSL_SESS_CACHE_CLIENT);
+    if (SSL_CTX_load_verify_locations(state->tls_ctx, TLS_CA_FILE, NULL) == 1)    // 로컬 self-signed 인증서를 CA로 신뢰
+        SSL_CTX_set_verify(state->tls_ctx, SSL_VERIFY_PEER, NULL);
+    else
+    {
+        fprintf(stderr, "client_tls_init() : %s 없음, 서버 인증서 검증 생략\n", TLS_CA_FILE);
+        ERR_clear_error();
+    }
+    return 0;
+}
+void
+client_tls_cleanup(ClientState *state)
+{
+    if (state->tls_handshakes > 0)
+        printf("[TLS] 핸드셰이크 %d회, 재개 %d회 (%.1f%%), 평균 %.3f ms\n", state->tls_handshakes, state->tls_resumed,
+               100.0 * state->tls_resumed / state->tls_handshakes, state->tls_handshake_ms / state->tls_handshakes);
+    SSL_SESSION_free(state->tls_session);
+    state->tls_session = NULL;
+    SSL_CTX_free(state->tls_ctx);
+    state->tls_ctx = NULL;
+}
+int
+client_tls_connect(ClientState *state, int sock, int client_id, struct ssl_st **out)
+{
+    struct timespec t0, t1;
+    SSL *ssl = SSL_new(state->tls_ctx);
+    if (ssl == NULL || SSL_set_fd(ssl, sock) != 1)
+    {
+        ERR_print_errors_fp(stderr);
+        SSL_free(ssl);
+        return -1;
+    }
+    if (state->tls_session)                                                         // 직전 연결의 세션으로 재개 시도 (full handshake 생략)
+        SSL_set_session(ssl, state->tls_session);
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    if (SSL_connect(ssl) != 1)
+    {
+        fprintf(stderr, "client_tls_connect() : [클라이언트 #%d] SSL_connect() 실패\n", client_id);
+        ERR_print_errors_fp(stderr);
+        SSL_free(ssl);
+        return -1;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double ms = (t1.tv_sec - t0.tv_sec) * 1000.0 + (t1.tv_nsec - t0.tv_nsec) / 1e6;
+    state->tls_handshakes++;
+    state->tls_handshake_ms += ms;
+    if (SSL_session_reused(ssl))
+        state->tls_resumed++;
+    printf("[클라이언트 #%d] TLS %s 핸드셰이크 %.3f ms (재개: %s)\n", client_id, SSL_get_version(ssl), ms, SSL_session_reused(ssl) ? "yes" : "no");
+    *out = ssl;
+    return 0;
+}
+void
+client_tls_close(ClientState *state, struct ssl_st *ssl)
+{
+    if (ssl == NULL)
+        return;
+    SSL_SESSION *session = SSL_get1_session(ssl);                                   // TLS 1.3 티켓은 핸드셰이크 이후 도착하므로 종료 시점에 저장
+    if (session && SSL_SESSION_is_resumable(session))
+    {
+        SSL_SESSION_free(state->tls_session);
+        state->tls_session = session;
+    }
+    else
+        SSL_SESSION_free(session);
+    SSL_shutdown(ssl);
+    SSL_free(ssl);
+}
+ssize_t
+client_read(struct ssl_st *ssl, int sock, void *buf, size_t len)
+{
+    if (ssl == NULL)
+        return read(sock, buf, len);
+    int ret = SSL_read(ssl, buf, (int)len);
+    if (ret > 0)
+        return ret;
+    int err = SSL_get_error(ssl, ret);
+    if (err == SSL_ERROR_ZERO_RETURN)
+        return 0;
+    if (err == SSL_ERROR_WANT_READ || err == SSL_ERROR_WANT_WRITE)
+        errno = EAGAIN;
+    else if (err != SSL_ERROR_SYSCALL)
+        errno = EPROTO;
+    return -1;
+}
+ssize_t
+client_write(struct ssl_st *ssl, int sock, const void *buf, size_t len)
+{
+    if (ssl == NULL)
+        return write(sock, buf, len);
+    int ret = SSL_write(ssl, buf, (int)len);
+    if (ret > 0)
+        return ret;
+    int err = SSL_get_error(ssl, ret);
+    if (err == SSL_ERROR_WANT_READ || err == SSL_ERROR_WANT_WRITE)
+        errno = EAGAIN;
+    else if (err != SSL_ERROR_SYSCALL)
+        errno = EPROTO;
+    return -1;
+}
+#else
+int
+client_tls_init(ClientState *state)
+{
+    state->tls_ctx = NULL;
+    return 0;
+}
+void
+client_tls_cleanup(ClientState *state)
+{
+    (void)state;
+}
+int
+client_tls_connect(ClientState *state, int sock, int client_id, struct ssl_st **out)
+{
+    (void)state;
+    (void)sock;
+    (void)client_id;
+    *out = NULL;
+    return 0;
+}
+void
+client_tls_close(ClientState *state, struct ssl_st *ssl)
+{
+    (void)state;
+    (void)ssl;
+}
+ssize_t
+client_read(struct ssl_st *ssl, int sock, void *buf, size_t len)
+{
+    (void)ssl;
+    return read(sock, buf, len);
+}
+ssize_t
+client_write(struct ssl_st *ssl, int sock, const void *buf, size_t len)
+{
+    (void)ssl;
+    return write(sock, buf, len);
+}
+#endif
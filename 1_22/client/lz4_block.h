@@ -0,0 +1,16 @@
+#ifndef LZ4_BLOCK_H
+#define LZ4_BLOCK_H
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#define LZ4_MIN_INPUT 32
+#define LZ4_COMPRESS_BOUND(n) ((n) + (n) / 255 + 16)
+extern int              lz4_compress_block(const uint8_t *src, int src_len, uint8_t *dst, int dst_cap);
+extern int              lz4_decompress_block(const uint8_t *src, int src_len, uint8_t *dst, int dst_cap);
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,118 @@
+#define _DEFAULT_SOURCE
+#include "server_function.h"
+#include <sys/mman.h>
+
+static ArenaChunk *arena_free_list = NULL;                                      // 워커 내 재사용 청크 (표준 크기만)
+static int arena_free_count = 0;
+static size_t arena_live_bytes = 0;                                             // 살아 있는 아레나에서 할당된 바이트
+static size_t arena_mapped_bytes = 0;                                           // mmap으로 확보한 전체 바이트 (free list 포함)
+
+static size_t
+arena_align(size_t n)
+{
+    return (n + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+}
+static ArenaChunk *
+arena_chunk_get(size_t min_size)
+{
+    size_t size = arena_align(sizeof(ArenaChunk)) + min_size;
+    if (size <= ARENA_CHUNK_SIZE && arena_free_list != NULL)                    // 표준 청크는 free list에서 먼저 꺼냄
+    {
+        ArenaChunk *chunk = arena_free_list;
+        arena_free_list = chunk->next;
+        arena_free_count--;
+        chunk->next = NULL;
+        chunk->used = arena_align(sizeof(ArenaChunk));
+        return chunk;
+    }
+    if (size < ARENA_CHUNK_SIZE)
+        size = ARENA_CHUNK_SIZE;
+    size = (size + 4095) & ~(size_t)4095;
+    ArenaChunk *chunk = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);  // malloc 힙과 분리
+    if (chunk == MAP_FAILED)
+        return NULL;
+    chunk->next = NULL;
+    chunk->size = size;
+    chunk->used = arena_align(sizeof(ArenaChunk));
+    arena_mapped_bytes += size;
+    return chunk;
+}
+static void
+arena_chunk_put(ArenaChunk *chunk)
+{
+    if (chunk->size == ARENA_CHUNK_SIZE && arena_free_count < ARENA_FREE_MAX)  // 다음 세션을 위해 보관
+    {
+        chunk->next = arena_free_list;
+        arena_free_list = chunk;
+        arena_free_count++;
+        return;
+    }
+    arena_mapped_bytes -= chunk->size;
+    munmap(chunk, chunk->size);
+}
+Arena *
+arena_create(void)
+{
+    ArenaChunk *chunk = arena_chunk_get(sizeof(Arena));
+    if (chunk == NULL)
+        return NULL;
+    Arena *arena = (Arena *)((uint8_t *)chunk + chunk->used);                   // 아레나 헤더도 첫 청크 안에 둠
+    chunk->used += arena_align(sizeof(Arena));
+    memset(arena, 0, sizeof(Arena));
+    arena->head = chunk;
+    arena->reserved = chunk->size;
+    return arena;
+}
+void *
+arena_alloc(Arena *arena, size_t size)
+{
+    size = arena_align(size ? size : 1);
+    ArenaChunk *chunk = arena->head;
+    if (chunk->used + size > chunk->size)                                       // 현재 청크 부족: 새 청크를 앞에 연결
+    {
+        chunk = arena_chunk_get(size);
+        if (chunk == NULL)
+            return NULL;
+        chunk->next = arena->head;
+        arena->head = chunk;
+        arena->reserved += chunk->size;
+    }
+    void *ptr = (uint8_t *)chunk + chunk->used;                                 // bump: 포인터 증가만
+    chunk->used += size;
+    arena->used += size;
+    arena->allocs++;
+    arena_live_bytes += size;
+    return ptr;
+}
+void *
+arena_calloc(Arena *arena, size_t size)
+{
+    void *ptr = arena_alloc(arena, size);
+    if (ptr != NULL)
+        memset(ptr, 0, size);                                                   // 재사용 청크는 0이 아닐 수 있음
+    return ptr;
+}
+void
+arena_release(Arena *arena)
+{
+    if (arena == NULL)
+        return;
+    arena_live_bytes -= arena->used;
+    ArenaChunk *chunk = arena->head;
+    while (chunk != NULL)                                                       // SESSION_CLOSED 시 청크 단위로 한 번에 반환
+    {
+        ArenaChunk *next = chunk->next;
+        arena_chunk_put(chunk);
+        chunk = next;
+    }
+}
+size_t
+arena_live_usage(void)
+{
+    return arena_live_bytes;
+}
+size_t
+arena_mapped_usage(void)
+{
+    return arena_mapped_bytes;
+}
@@ -0,0 +1,113 @@
+#define _GNU_SOURCE
+#include "server_function.h"
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#ifndef SO_PREFER_BUSY_POLL
+#define SO_PREFER_BUSY_POLL 69
+#endif
+
+static void
+busy_poll_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();                                                     // 스핀 중 하이퍼스레드 양보 및 전력 절감
+#endif
+}
+int
+busy_poll_enabled(void)
+{
+    return getenv(BUSY_POLL_ENV) != NULL;                                       // 옵트인: ECHO_BUSY_POLL=<cpu 번호 | -1>
+}
+int
+busy_poll_setup(SessionDescriptor *session, BusyPoll *busy)
+{
+    memset(busy, 0, sizeof(*busy));
+    busy->epfd = -1;
+    busy->cpu = atoi(getenv(BUSY_POLL_ENV));
+    if (busy->cpu >= 0)                                                         // 격리된 코어에 고정 (isolcpus 등으로 분리된 코어 권장)
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(busy->cpu, &set);
+        if (sched_setaffinity(0, sizeof(set), &set) == -1)
+            fprintf(stderr, "busy_poll_setup() : [자식 #%d] CPU %d 고정 실패: %s\n", session->session_id, busy->cpu, strerror(errno));
+    }
+    int usec = BUSY_POLL_USEC;
+    if (setsockopt(session->sock, SOL_SOCKET, SO_BUSY_POLL, &usec, sizeof(usec)) == -1)      // 권한(CAP_NET_ADMIN) 없으면 무시
+        fprintf(stderr, "busy_poll_setup() : [자식 #%d] SO_BUSY_POLL 미적용: %s\n", session->session_id, strerror(errno));
+    int prefer = 1;
+    if (setsockopt(session->sock, SOL_SOCKET, SO_PREFER_BUSY_POLL, &prefer, sizeof(prefer)) == -1)
+        fprintf(stderr, "busy_poll_setup() : [자식 #%d] SO_PREFER_BUSY_POLL 미적용: %s\n", session->session_id, strerror(errno));
+    busy->epfd = epoll_create1(EPOLL_CLOEXEC);                                  // idle 시 폴백용
+    if (busy->epfd == -1)
+    {
+        fprintf(stderr, "busy_poll_setup() : [자식 #%d] epoll_create1() 실패: %s\n", session->session_id, strerror(errno));
+        return -1;
+    }
+    struct epoll_event ev = {.events = EPOLLIN | EPOLLRDHUP, .data.fd = session->sock};
+    if (epoll_ctl(busy->epfd, EPOLL_CTL_ADD, session->sock, &ev) == -1)
+    {
+        fprintf(stderr, "busy_poll_setup() : [자식 #%d] epoll_ctl() 실패: %s\n", session->session_id, strerror(errno));
+        close(busy->epfd);
+        busy->epfd = -1;
+        return -1;
+    }
+    busy->spinning = 1;
+    busy->last_data_ms = timer_wheel_clock_ms();
+    printf("[자식 #%d] busy-poll 모드 (CPU %d, 예산 %dms)\n", session->session_id, busy->cpu, BUSY_POLL_BUDGET_MS);
+    return 0;
+}
+int
+busy_poll_wait(ServerState *state, SessionDescriptor *session, BusyPoll *busy, TimerWheel *wheel)
+{
+    if (session_pending(session) > 0)
+        return 1;
+    if (busy->spinning)
+    {
+        for (unsigned long spins = 1; ; spins++)                                // 논블로킹 recv로 스핀 (poll 타임아웃 없음)
+        {
+            char probe;
+            ssize_t n = recv(session->sock, &probe, 1, MSG_PEEK | MSG_DONTWAIT);
+            if (n >= 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))   // 데이터, EOF, 에러 모두 read 경로에서 처리
+            {
+                busy->spin_wakeups++;
+                busy->last_data_ms = timer_wheel_clock_ms();
+                return 1;
+            }
+            if ((spins & (BUSY_POLL_CLOCK_CHECK - 1)) == 0)                     // 시계/타이머는 일정 횟수마다만 확인
+            {
+                timer_wheel_advance(wheel);
+                if (session->state != SESSION_ACTIVE || !state->running)
+                    return 0;
+                if (wheel->now_ms - busy->last_data_ms >= BUSY_POLL_BUDGET_MS) // CPU 예산 소진: epoll로 내려가 코어 반납
+                {
+                    busy->spinning = 0;
+                    busy->fallbacks++;
+                    break;
+                }
+            }
+            busy_poll_relax();
+        }
+    }
+    struct epoll_event ev;
+    int n = epoll_wait(busy->epfd, &ev, 1, timer_wheel_next_timeout(wheel, POLL_TIMEOUT));
+    if (n == -1)
+        return errno == EINTR ? 0 : -1;
+    if (n == 0)
+        return 0;
+    busy->epoll_wakeups++;
+    busy->spinning = 1;                                                         // 다시 활동이 생기면 스핀 재개
+    busy->last_data_ms = timer_wheel_clock_ms();
+    return 1;
+}
+void
+busy_poll_close(SessionDescriptor *session, BusyPoll *busy)
+{
+    if (busy->epfd < 0)
+        return;
+    printf("[자식 #%d] busy-poll 통계: 스핀 수신 %lu회, epoll 수신 %lu회, 폴백 %lu회\n",
+           session->session_id, busy->spin_wakeups, busy->epoll_wakeups, busy->fallbacks);
+    close(busy->epfd);
+    busy->epfd = -1;
+}
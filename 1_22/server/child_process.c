@@ -1,5 +1,268 @@
+#define LOG_MODULE LOG_MODULE_WORKER
 #include "server_function.h"
+#include <fcntl.h>
 
+static void
+session_idle_expired(TimerNode *timer, void *arg)
+{
+    (void)timer;
+    SessionDescriptor *session = arg;
+    session->state = SESSION_CLOSING;                                           // 루프 조건에서 빠져나오도록 상태 변경
+    session->close_reason = "idle 타임아웃";
+}
+static void
+session_write_stalled(TimerNode *timer, void *arg)
+{
+    (void)timer;
+    SessionDescriptor *session = arg;
+    session->state = SESSION_CLOSING;
+    session->close_reason = "write stall 타임아웃";
+}
+static void
+session_tcp_info_due(TimerNode *timer, void *arg)
+{
+    (void)timer;
+    SessionDescriptor *session = arg;
+    session->tcp_info_due = 1;                                                  // 샘플링은 루프에서 (콜백은 휠 포인터가 없어 재등록 불가)
+}
+static int
+session_send_all(SessionDescriptor *session, TimerWheel *wheel, const void *data, size_t len)
+{
+    const char *buf = data;
+    size_t sent = 0;
+    while (sent < len && session->state == SESSION_ACTIVE)
+    {
+        ssize_t write_result = session_write(session, buf + sent, len - sent);     // 클라이언트에 데이터 전송
+        if (write_result == -1) 
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK)                            // 송신 버퍼 가득참: stall 데드라인 안에서 대기
+            {
+                if (!timer_is_armed(&session->write_timer))
+                    timer_arm(wheel, &session->write_timer, WRITE_STALL_TIMEOUT, session_write_stalled, session);
+                struct pollfd write_pfd = {.fd = session->sock, .events = POLLOUT, .revents = 0};
+                if (poll(&write_pfd, 1, timer_wheel_next_timeout(wheel, POLL_TIMEOUT)) == -1 && errno != EINTR)
+                {
+                    fprintf(stderr, "session_send_all() : [자식 #%d] write poll() error: %s\n", session->session_id, strerror(errno));
+                    break;
+                }
+                timer_wheel_advance(wheel);
+                continue;
+            }
+            else if (errno == EPIPE) 
+            {
+                fprintf(stderr, "session_send_all() : [자식 #%d] write() EPIPE: 클라이언트 연결 끊김\n", session->session_id);
+                break;
+            }
+            fprintf(stderr, "session_send_all() : [자식 #%d] write() error: %s\n", session->session_id, strerror(errno));
+            break;
+        }
+        sent += write_result;                                                       // 전송된 바이트 수 누적
+    }
+    timer_cancel(wheel, &session->write_timer);
+    return sent < len ? -1 : 0;
+}
+static double
+elapsed_ms(const struct timespec *t0)
+{
+    struct timespec t1;
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    return (t1.tv_sec - t0->tv_sec) * 1000.0 + (t1.tv_nsec - t0->tv_nsec) / 1e6;
+}
+static long
+session_build_reply(SessionDescriptor *session, uint8_t type, uint8_t flags, const uint8_t *payload, uint32_t len)
+{
+    uint8_t *body = session->outbuf + FRAME_HEADER_SIZE;
+    if ((type == FRAME_TYPE_DATA || type == FRAME_TYPE_MESSAGE) && (session->caps & FRAME_CAP_LZ4) && len >= LZ4_MIN_INPUT)  // 협상된 세션만 압축 시도
+    {
+        struct timespec t0;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        int comp_len = lz4_compress_block(payload, (int)len, body + FRAME_LZ4_PREFIX, (int)len - FRAME_LZ4_PREFIX - 1);
+        session->compress_ms += elapsed_ms(&t0);
+        if (comp_len > 0)                                                           // 줄어든 경우에만 LZ4 프레임 사용, 아니면 원본 전송
+        {
+            body[0] = (uint8_t)(len >> 24);
+            body[1] = (uint8_t)(len >> 16);
+            body[2] = (uint8_t)(len >> 8);
+            body[3] = (uint8_t)len;
+            session->raw_out += len;
+            return frame_build(session->outbuf, sizeof(session->outbuf), type, flags | FRAME_FLAG_LZ4, body, (uint32_t)(comp_len + FRAME_LZ4_PREFIX));
+        }
+    }
+    session->raw_out += len;
+    return frame_build(session->outbuf, sizeof(session->outbuf), type, flags, payload, len);
+}
+static void
+session_buffer_output(SessionDescriptor *session, const uint8_t *frame, size_t len)
+{
+    if (session->pending_len + len > sizeof(session->pending))                  // 재개 시 보낼 프레임만 통째로 보관 (넘치면 버림)
+        return;
+    memcpy(session->pending + session->pending_len, frame, len);
+    session->pending_len += len;
+}
+static long
+session_handle_hello(ServerState *state, SessionDescriptor *session, uint8_t flags, const uint8_t *payload, uint32_t payload_len)
+{
+    uint8_t requested = payload_len > 0 ? payload[0] : 0;
+    uint8_t reply[18];
+    int resumed = 0;
+    if ((requested & FRAME_CAP_RESUME) && payload_len >= 9)                     // [caps][토큰 8바이트]: 이전 세션 재개 요청
+    {
+        uint64_t token = 0;
+        for (int i = 0; i < 8; i++)
+            token = token << 8 | payload[1 + i];
+        int connection_id = session->session_id;                               // 재개하면 session_id가 이전 세션 번호로 바뀜
+        if (session_table_resume(state, session, token) == 0)
+        {
+            resumed = 1;
+            printf("[자식 #%d] 세션 재개: Session #%d, io_count %d, 미전송 %zu bytes\n", connection_id, session->session_id, session->io_count, session->pending_len);
+        }
+    }
+    if (!resumed)
+        session->caps = requested & FRAME_SERVER_CAPS;
+    if ((session->caps & FRAME_CAP_RESUME) && session->resume_token == 0)
+        session_table_issue(state, session);
+    reply[0] = session->caps;
+    for (int i = 0; i < 8; i++)
+        reply[1 + i] = (uint8_t)(session->resume_token >> (56 - 8 * i));
+    reply[9] = (uint8_t)resumed;
+    reply[10] = (uint8_t)(session->io_count >> 24);
+    reply[11] = (uint8_t)(session->io_count >> 16);
+    reply[12] = (uint8_t)(session->io_count >> 8);
+    reply[13] = (uint8_t)session->io_count;
+    reply[14] = (uint8_t)(session->pending_len >> 24);                          // 이어서 보낼 미전송 출력 크기
+    reply[15] = (uint8_t)(session->pending_len >> 16);
+    reply[16] = (uint8_t)(session->pending_len >> 8);
+    reply[17] = (uint8_t)session->pending_len;
+    return session_build_reply(session, FRAME_TYPE_HELLO, flags & FRAME_FLAG_CRC, reply, sizeof(reply));
+}
+static long
+session_handle_pubsub(ServerState *state, SessionDescriptor *session, uint8_t type, const uint8_t *payload, uint32_t payload_len)
+{
+    long result = 0;
+    if (type == FRAME_TYPE_SUBSCRIBE)                                               // 페이로드 = 토픽 이름
+        result = pubsub_subscribe(state, session, payload, payload_len);
+    else if (type == FRAME_TYPE_UNSUBSCRIBE)
+        pubsub_unsubscribe(state, session);
+    else                                                                            // [토픽 길이][토픽][본문] → 전달된 구독자 수
+        result = pubsub_publish(state, session, payload, payload_len);
+    uint32_t status = result < 0 ? UINT32_MAX : (uint32_t)result;
+    uint8_t reply[4] = {(uint8_t)(status >> 24), (uint8_t)(status >> 16), (uint8_t)(status >> 8), (uint8_t)status};
+    return session_build_reply(session, type, session->reply_flags, reply, sizeof(reply));
+}
+static int
+session_deliver_messages(ServerState *state, SessionDescriptor *session, TimerWheel *wheel)
+{
+    uint32_t idx;
+    const PubSubMessage *msg;
+    worker_registry_activity(state, WORKER_WRITING);
+    while ((msg = pubsub_next(state, session, &idx)) != NULL)                       // 공유 버퍼에서 바로 프레임 구성, 전송 후 참조 반납
+    {
+        long out_len = session_build_reply(session, FRAME_TYPE_MESSAGE, session->reply_flags, msg->data, msg->len);
+        pubsub_release(state, idx);
+        if (out_len < 0 || session_send_all(session, wheel, session->outbuf, (size_t)out_len) == -1)
+            return -1;
+        session->wire_out += (unsigned long)out_len;
+        worker_registry_account(state, 0, (size_t)out_len);
+        session->received++;
+    }
+    timer_arm(wheel, &session->idle_timer, SESSION_IDLE_TIMEOUT * 1000L, session_idle_expired, session);
+    return 0;
+}
+static int
+session_process_frames(ServerState *state, SessionDescriptor *session, TimerWheel *wheel)
+{
+    size_t offset = 0;
+    for (;;)                                                                        // 버퍼에 완성된 프레임을 모두 처리
+    {
+        FrameHeader hdr;
+        long frame_len = frame_parse(session->inbuf + offset, session->in_len - offset, &hdr);
+        if (frame_len == 0)
+            break;
+        if (frame_len == -2)
+        {
+            session->crc_errors++;
+            session->close_reason = "CRC32C 불일치";
+            return -1;
+        }
+        if (frame_len < 0 || hdr.type < FRAME_TYPE_DATA || hdr.type > FRAME_TYPE_PUBLISH)
+        {
+            session->close_reason = "잘못된 프레임";
+            return -1;
+        }
+        session->wire_in += (unsigned long)frame_len;
+        session->reply_flags = hdr.flags & FRAME_FLAG_CRC;                         // 요청에 CRC가 있으면 응답/구독 메시지에도 계산
+        const uint8_t *payload = hdr.payload;
+        uint32_t payload_len = hdr.length;
+        if (hdr.flags & FRAME_FLAG_LZ4)                                             // 압축 프레임: [원본 길이][LZ4 블록]
+        {
+            struct timespec t0;
+            clock_gettime(CLOCK_MONOTONIC, &t0);
+            int raw_len = -1;
+            if ((session->caps & FRAME_CAP_LZ4) && payload_len > FRAME_LZ4_PREFIX)
+                raw_len = lz4_decompress_block(payload + FRAME_LZ4_PREFIX, (int)(payload_len - FRAME_LZ4_PREFIX), session->scratch, sizeof(session->scratch));
+            session->decompress_ms += elapsed_ms(&t0);
+            uint32_t expected = (uint32_t)payload[0] << 24 | (uint32_t)payload[1] << 16 | (uint32_t)payload[2] << 8 | payload[3];
+            if (raw_len < 0 || (uint32_t)raw_len != expected)
+            {
+                session->close_reason = "LZ4 해제 실패";
+                return -1;
+            }
+            payload = session->scratch;
+            payload_len = (uint32_t)raw_len;
+        }
+        session->raw_in += payload_len;
+        long out_len;
+        if (hdr.type == FRAME_TYPE_HELLO)                                           // 기능 협상 + 재개 토큰 발급/검증
+            out_len = session_handle_hello(state, session, hdr.flags, payload, payload_len);
+        else if (hdr.type != FRAME_TYPE_DATA)                                       // 구독/해지/발행
+            out_len = session_handle_pubsub(state, session, hdr.type, payload, payload_len);
+        else                                                                        // DATA: 첫 토큰으로 명령 선택 (ECHO, STATS, UPPER, ...)
+        {
+            const uint8_t *reply;
+            struct timespec t0;
+            clock_gettime(CLOCK_MONOTONIC, &t0);
+            long reply_len = command_dispatch(state, session, payload, payload_len, session->scratch, sizeof(session->scratch), &reply);
+            session->tcp.server_us_sum += elapsed_ms(&t0) * 1000.0;                // 서버 측 처리 시간 (네트워크 RTT와 비교용)
+            if (reply_len < 0)
+                return -1;
+            out_len = reply_len > 0 ? session_build_reply(session, FRAME_TYPE_DATA, session->reply_flags, reply, (uint32_t)reply_len) : 0;
+        }
+        if (out_len < 0)
+            return -1;
+        worker_registry_activity(state, WORKER_WRITING);
+        if (out_len > 0 && session_send_all(session, wheel, session->outbuf, (size_t)out_len) == -1)   // DISCARD는 응답 없음
+        {
+            if (hdr.type == FRAME_TYPE_DATA)
+                session_buffer_output(session, session->outbuf, (size_t)out_len);
+            return -1;
+        }
+        session->wire_out += (unsigned long)out_len;
+        worker_registry_account(state, 0, (size_t)out_len);
+        offset += (size_t)frame_len;
+        if (hdr.type == FRAME_TYPE_HELLO && session->pending_len > 0)              // 재개된 세션: 끊기기 전 못 보낸 출력부터 전달
+        {
+            if (session_send_all(session, wheel, session->pending, session->pending_len) == -1)
+                return -1;
+            session->wire_out += session->pending_len;
+            worker_registry_account(state, 0, session->pending_len);
+            session->pending_len = 0;
+        }
+        if (hdr.type == FRAME_TYPE_DATA)
+        {
+            session->io_count++;
+            log_message_sampled(state, LOG_DEBUG, LOG_IO_SAMPLE, "[자식 #%d] I/O 완료: %d/%d", session->session_id, session->io_count, IO_TARGET);   // 요청마다: 1/N만 기록
+        }
+    }
+    if (offset > 0)                                                                 // 남은 조각을 버퍼 앞으로 이동
+    {
+        memmove(session->inbuf, session->inbuf + offset, session->in_len - offset);
+        session->in_len -= offset;
+    }
+    timer_arm(wheel, &session->idle_timer, SESSION_IDLE_TIMEOUT * 1000L, session_idle_expired, session);
+    return 0;
+}
 void 
 child_process_main(int client_sock, int session_id, struct sockaddr_in client_addr, ServerState *state)
 {
@@ -11,14 +274,16 @@ child_process_main(int client_sock, int session_id, struct sockaddr_in client_ad
     monitor.start_time = time(NULL);
     monitor.active_sessions = 1;
     monitor.total_sessions = 1;
-    SessionDescriptor *session = malloc(sizeof(SessionDescriptor));             // 세션 정보 기록을 위한 메모리 할당
+    Arena *arena = arena_create();                                              // 세션 수명 동안의 할당은 모두 이 아레나에서
+    SessionDescriptor *session = arena ? arena_calloc(arena, sizeof(SessionDescriptor)) : NULL;
     if (!session) 
     {
-        perror("child_process_main() : malloc");
+        fprintf(stderr, "child_process_main() : [자식 #%d] 세션 아레나 할당 실패\n", session_id);
+        arena_release(arena);
         close(client_sock);
         return;
     }
-    memset(session, 0, sizeof(SessionDescriptor));
+    session->arena = arena;
     session->sock = client_sock;
     session->addr = client_addr;
     session->session_id = session_id;
@@ -26,21 +291,49 @@ child_process_main(int client_sock, int session_id, struct sockaddr_in client_ad
     session->start_time = time(NULL);
     session->last_activity = time(NULL);
     session->io_count = 0;
+    session->pubsub_slot = -1;
+    session->doorbell = -1;
+    TimerWheel wheel;                                                           // 세션 타이머 (idle, write stall)
+    timer_wheel_init(&wheel);
+    timer_arm(&wheel, &session->idle_timer, SESSION_IDLE_TIMEOUT * 1000L, session_idle_expired, session);
+    int tcp_info_ms = tcp_telemetry_interval_ms();
+    if (tcp_info_ms > 0)                                                        // 주기적 TCP_INFO 샘플링
+        timer_arm(&wheel, &session->tcp_info_timer, tcp_info_ms, session_tcp_info_due, session);
+    int sock_flags = fcntl(session->sock, F_GETFL);                             // write stall 감지를 위해 논블로킹 전환
+    if (sock_flags == -1 || fcntl(session->sock, F_SETFL, sock_flags | O_NONBLOCK) == -1)
+        fprintf(stderr, "child_process_main() : [자식 #%d] O_NONBLOCK 설정 실패: %s\n", session_id, strerror(errno));
+    if (tls_session_accept(state, session, TLS_HANDSHAKE_TIMEOUT) == -1)       // TLS 빌드에서만 핸드셰이크 수행
+    {
+        fprintf(stderr, "child_process_main() : [자식 #%d] TLS 핸드셰이크 실패\n", session_id);
+        close(client_sock);
+        arena_release(arena);
+        return;
+    }
+    BusyPoll busy = {.epfd = -1};
+    int busy_mode = busy_poll_enabled() && busy_poll_setup(session, &busy) == 0;   // 저지연 세션 옵트인
     monitor_resources(&monitor);                                                // 초기 리소스 상태 측정
     print_resource_status(&monitor);                                            // 초기 리소스 상태 측정
-    char buf[BUF_SIZE];
-    struct pollfd read_pfd = {.fd = session->sock, .events = POLLIN, .revents = 0}; // 초기 리소스 상태 측정
+    struct pollfd pfds[2] = {{.fd = session->sock, .events = POLLIN}, {.fd = -1, .events = POLLIN}};   // [0] 클라이언트, [1] 구독 도어벨
     while (session->io_count < IO_TARGET && session->state == SESSION_ACTIVE && state->running) // 목표 횟수 및 서버 가동 중인 동안 루프
     {
-        time_t current_time = time(NULL);
-        time_t idle_duration = current_time - session->last_activity;
-        if (idle_duration >= SESSION_IDLE_TIMEOUT)              // 1분간 무응답 시 타임아웃 종료
+        pfds[0].revents = 0;
+        pfds[1].revents = 0;
+        pfds[1].fd = session->doorbell;                                         // 구독 전에는 -1 → poll이 무시
+        worker_registry_activity(state, WORKER_IDLE);                           // 스코어보드: 다음 요청 대기
+        int poll_timeout = timer_wheel_next_timeout(&wheel, POLL_TIMEOUT);     // 가장 가까운 타이머 만료까지만 대기
+        int read_ret;
+        if (busy_mode && session->pubsub_slot < 0)                              // 스핀 → 예산 소진 시 epoll 폴백 (구독 중에는 도어벨 때문에 poll 사용)
         {
-            fprintf(stderr, "child_process_main() : [자식 #%d] idle 타임아웃 (%ld초 무활동)\n", session_id, idle_duration);
-            break;
+            read_ret = busy_poll_wait(state, session, &busy, &wheel);
+            pfds[0].revents = read_ret > 0 ? POLLIN : 0;
         }
-        read_pfd.revents = 0;
-        int read_ret = poll(&read_pfd, 1, POLL_TIMEOUT);
+        else if (session_pending(session) > 0)                                       // TLS 버퍼에 남은 데이터는 poll에 보이지 않음
+        {
+            pfds[0].revents = POLLIN;
+            read_ret = 1;
+        }
+        else
+            read_ret = poll(pfds, 2, poll_timeout);
         if (read_ret == -1) 
         {
             if (errno == EINTR) 
@@ -51,19 +344,43 @@ child_process_main(int client_sock, int session_id, struct sockaddr_in client_ad
             fprintf(stderr, "child_process_main() : [자식 #%d] poll() error: %s\n", session_id, strerror(errno));
             break;
         } 
-        else if (read_ret == 0) 
+        timer_wheel_advance(&wheel);                                            // 캐시된 tick 갱신 및 만료 타이머 실행
+        log_report_suppressed(state, 0);                                        // 제한된 로그의 생략 건수를 주기적으로 보고
+        if (session->tcp_info_due)
         {
-            fprintf(stderr, "child_process_main() : [자식 #%d] poll 타임아웃\n", session_id);
+            session->tcp_info_due = 0;
+            tcp_telemetry_sample(session);
+            timer_arm(&wheel, &session->tcp_info_timer, tcp_info_ms, session_tcp_info_due, session);
+        }
+        if (session->state != SESSION_ACTIVE)
+            break;
+        if (read_ret == 0) 
+        {
+            if (poll_timeout == POLL_TIMEOUT)
+                log_message_limited(state, LOG_WARNING, LOG_POLL_TIMEOUT_PER_SEC, "child_process_main() : [자식 #%d] poll 타임아웃", session_id);
             continue;
         }
-        if (read_pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) 
+        if (pfds[1].revents & POLLIN)                                           // 구독 inbox에 새 메시지
         {
-            fprintf(stderr, "child_process_main() : [자식 #%d] poll 에러 이벤트: 0x%x\n", session_id, read_pfd.revents);
+            if (session_deliver_messages(state, session, &wheel) == -1)
+                break;
+            if (pfds[0].revents == 0)
+                continue;
+        }
+        if (pfds[0].revents & (POLLERR | POLLHUP | POLLNVAL)) 
+        {
+            fprintf(stderr, "child_process_main() : [자식 #%d] poll 에러 이벤트: 0x%x\n", session_id, pfds[0].revents);
             break;
         } 
-        else if (read_pfd.revents & POLLIN) 
+        else if (pfds[0].revents & POLLIN) 
         {
-            ssize_t str_len = read(session->sock, buf, BUF_SIZE - 1);
+            worker_registry_activity(state, WORKER_READING);
+            if (session->in_len >= sizeof(session->inbuf) - 1)                             // 가득 찬 버퍼로 read하면 0이 돌아와 EOF로 오인됨
+            {
+                fprintf(stderr, "child_process_main() : [자식 #%d] 입력 버퍼 가득 참 (%zu bytes), 세션 종료\n", session_id, session->in_len);
+                break;
+            }
+            ssize_t str_len = session_read(session, session->inbuf + session->in_len, sizeof(session->inbuf) - session->in_len - 1);
             if (str_len == 0) 
             {
                 printf("child_process_main() : [자식 #%d] 클라이언트 정상 연결 종료 (EOF)\n", session_id);
@@ -80,48 +397,96 @@ child_process_main(int client_sock, int session_id, struct sockaddr_in client_ad
                 break;
             }
             session->last_activity = time(NULL);
-            buf[str_len] = 0;                                                               // 문자열 끝에 null 삽입
-            ssize_t sent = 0;
-            while (sent < str_len)                                                          // 받은 만큼 그대로 돌려주는 에코 루프
+            session->in_len += (size_t)str_len;
+            worker_registry_account(state, (size_t)str_len, 0);                            // 부모가 보는 Worker 레코드 갱신
+            if (!session->framing_checked)                                                  // 첫 바이트로 프레임 모드 판별 (텍스트는 0xFE로 시작하지 않음)
             {
-                ssize_t write_result = write(session->sock, buf + sent, str_len - sent);    // 클라이언트에 데이터 전송
-                if (write_result == -1) 
-                {
-                    if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK) 
-                        continue;
-                    else if (errno == EPIPE) 
-                    {
-                        fprintf(stderr, "child_process_main() : [자식 #%d] write() EPIPE: 클라이언트 연결 끊김\n", session_id);
-                        break;
-                    }
-                    fprintf(stderr, "child_process_main() : [자식 #%d] write() error: %s\n", session_id, strerror(errno));
+                session->framing_checked = 1;
+                session->framed = (session->inbuf[0] == FRAME_MAGIC);
+                if (session->framed)
+                    printf("[자식 #%d] 프레임 모드 (crc32c: %s)\n", session_id, crc32c_impl_name());
+            }
+            if (session->framed)
+            {
+                if (session_process_frames(state, session, &wheel) == -1)
                     break;
-                }
-                sent += write_result;                                                       // 전송된 바이트 수 누적
+                continue;
             }
-            if (sent < str_len)
+            const uint8_t *reply;
+            struct timespec t0;
+            clock_gettime(CLOCK_MONOTONIC, &t0);
+            long reply_len = command_dispatch(state, session, session->inbuf, session->in_len, session->outbuf, sizeof(session->outbuf), &reply);  // 명령이 아니면 그대로 에코
+            session->tcp.server_us_sum += elapsed_ms(&t0) * 1000.0;
+            if (reply_len < 0)
+                break;
+            worker_registry_activity(state, WORKER_WRITING);
+            if (reply_len > 0 && session_send_all(session, &wheel, reply, (size_t)reply_len) == -1)
                 break;
+            worker_registry_account(state, 0, (size_t)reply_len);
+            session->in_len = 0;
             session->io_count++;
             session->last_activity = time(NULL);
-            printf("[자식 #%d] I/O 완료: %d/%d\n", session_id, session->io_count, IO_TARGET);
+            timer_arm(&wheel, &session->idle_timer, SESSION_IDLE_TIMEOUT * 1000L, session_idle_expired, session);  // 활동 시 idle 타이머 재설정 (O(1))
+            log_message_sampled(state, LOG_DEBUG, LOG_IO_SAMPLE, "[자식 #%d] I/O 완료: %d/%d", session_id, session->io_count, IO_TARGET);
         } 
         else 
         {
-            fprintf(stderr, "child_process_main() : [자식 #%d] 예상 못한 revents=0x%x\n", session_id, read_pfd.revents);
+            fprintf(stderr, "child_process_main() : [자식 #%d] 예상 못한 revents=0x%x\n", session_id, pfds[0].revents);
             break;
         }
     }
+    worker_registry_activity(state, WORKER_CLOSING);
+    if (session->close_reason)
+        fprintf(stderr, "child_process_main() : [자식 #%d] %s로 세션 종료\n", session_id, session->close_reason);
+    timer_cancel(&wheel, &session->idle_timer);
+    timer_cancel(&wheel, &session->write_timer);
+    timer_cancel(&wheel, &session->tcp_info_timer);
     session->state = SESSION_CLOSED;
     time_t end_time = time(NULL);
     if (!state->running)
         printf("[자식 #%d (PID:%d)] SIGTERM으로 인한 graceful shutdown - %d I/O 완료, %ld초 소요\n", session_id, getpid(), session->io_count, end_time - session->start_time);
     else
         printf("[자식 #%d (PID:%d)] 처리 완료 - %d I/O 완료, %ld초 소요\n", session_id, getpid(), session->io_count, end_time - session->start_time);
+    if (session->framed)
+    {
+        printf("[자식 #%d] 프레임 통계: 수신 wire %lu / raw %lu bytes, 송신 wire %lu / raw %lu bytes\n",
+               session_id, session->wire_in, session->raw_in, session->wire_out, session->raw_out);
+        if (session->caps & FRAME_CAP_LZ4)
+            printf("[자식 #%d] LZ4: 압축 %.2f ms/MB, 해제 %.2f ms/MB\n", session_id,
+                   session->raw_out ? session->compress_ms * 1048576.0 / session->raw_out : 0.0,
+                   session->raw_in ? session->decompress_ms * 1048576.0 / session->raw_in : 0.0);
+    }
+    if (session->command_counts[COMMAND_ECHO] != (unsigned long)session->io_count)  // 에코 외 명령을 쓴 세션만 분포 출력
+    {
+        printf("[자식 #%d] 명령 통계:", session_id);
+        for (int id = 0; id < COMMAND_COUNT; id++)
+            if (session->command_counts[id] > 0)
+                printf(" %s=%lu", command_name((CommandId)id), session->command_counts[id]);
+        printf("\n");
+    }
+    pubsub_unsubscribe(state, session);                                          // 남은 inbox 참조 반납
+    if (session->published > 0)
+        printf("[자식 #%d] pub/sub 발행: %lu건, 전달 %lu건 (평균 fanout %.1f, 느린 구독자 드롭 %lu건), fanout 처리량 %.0f 전달/s\n", session_id,
+               session->published, session->fanout, (double)session->fanout / session->published, session->pubsub_dropped,
+               session->fanout_ms > 0 ? session->fanout * 1000.0 / session->fanout_ms : 0.0);
+    else if (session->received > 0 || session->pubsub_dropped > 0)
+        printf("[자식 #%d] pub/sub 수신: %lu건, inbox 가득 참으로 드롭 %lu건\n", session_id, session->received, session->pubsub_dropped);
+    if (session->resume_token != 0 && session->io_count < IO_TARGET)         // 미완료 세션은 재개 유효 시간 동안 보관
+    {
+        session_table_park(state, session);
+        printf("[자식 #%d] 세션 보관 (%d초 내 재접속 시 재개)\n", session_id, SESSION_RESUME_WINDOW);
+    }
+    else
+        session_table_release(state, session);
+    tcp_telemetry_close(state, session);                                            // 최종 샘플 + 로그 + 워커 간 합계
+    busy_poll_close(session, &busy);
     monitor.active_sessions--;
+    tls_session_close(session);
     if (close(client_sock) == -1)
         fprintf(stderr, "child_process_main() : [자식 #%d] close(client_sock) 실패: %s\n", session_id, strerror(errno));
     monitor_resources(&monitor);
     print_resource_status(&monitor);
-    free(session);                                                                  // 세션 메모리 해제
+    printf("[자식 #%d] 세션 아레나: %zu bytes 사용, %lu회 할당, %zu bytes 확보\n", session_id, arena->used, arena->allocs, arena->reserved);
+    arena_release(arena);                                                           // SESSION_CLOSED: 세션 메모리를 한 번에 반환
     printf("[자식 #%d (PID:%d)] 정상 종료\n\n", session_id, getpid());
 }
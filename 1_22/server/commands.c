@@ -0,0 +1,168 @@
+#define LOG_MODULE LOG_MODULE_WORKER
+#include "server_function.h"
+
+static long command_echo(ServerState *state, SessionDescriptor *session, const uint8_t *args, size_t len, uint8_t *out, size_t cap, const uint8_t **reply);
+static long command_stats(ServerState *state, SessionDescriptor *session, const uint8_t *args, size_t len, uint8_t *out, size_t cap, const uint8_t **reply);
+static long command_upper(ServerState *state, SessionDescriptor *session, const uint8_t *args, size_t len, uint8_t *out, size_t cap, const uint8_t **reply);
+static long command_sleep(ServerState *state, SessionDescriptor *session, const uint8_t *args, size_t len, uint8_t *out, size_t cap, const uint8_t **reply);
+static long command_discard(ServerState *state, SessionDescriptor *session, const uint8_t *args, size_t len, uint8_t *out, size_t cap, const uint8_t **reply);
+static long command_sink(ServerState *state, SessionDescriptor *session, const uint8_t *args, size_t len, uint8_t *out, size_t cap, const uint8_t **reply);
+static long command_loglevel(ServerState *state, SessionDescriptor *session, const uint8_t *args, size_t len, uint8_t *out, size_t cap, const uint8_t **reply);
+
+static const CommandEntry command_names[COMMAND_COUNT] =
+{
+    [COMMAND_ECHO]    = {"ECHO", 4, COMMAND_ECHO, command_echo},
+    [COMMAND_STATS]   = {"STATS", 5, COMMAND_STATS, command_stats},
+    [COMMAND_UPPER]   = {"UPPER", 5, COMMAND_UPPER, command_upper},
+    [COMMAND_SLEEP]   = {"SLEEP", 5, COMMAND_SLEEP, command_sleep},
+    [COMMAND_DISCARD] = {"DISCARD", 7, COMMAND_DISCARD, command_discard},
+    [COMMAND_SINK]    = {"SINK", 4, COMMAND_SINK, command_sink},
+    [COMMAND_LOGLEVEL] = {"LOGLEVEL", 8, COMMAND_LOGLEVEL, command_loglevel},
+};
+static const CommandEntry *const command_table[COMMAND_HASH_SIZE] =             // 완전 해시: (첫 글자 + 둘째 글자) & 15 → 충돌 없음
+{
+    [('E' + 'C') & (COMMAND_HASH_SIZE - 1)] = &command_names[COMMAND_ECHO],
+    [('S' + 'T') & (COMMAND_HASH_SIZE - 1)] = &command_names[COMMAND_STATS],
+    [('U' + 'P') & (COMMAND_HASH_SIZE - 1)] = &command_names[COMMAND_UPPER],
+    [('S' + 'L') & (COMMAND_HASH_SIZE - 1)] = &command_names[COMMAND_SLEEP],
+    [('D' + 'I') & (COMMAND_HASH_SIZE - 1)] = &command_names[COMMAND_DISCARD],
+    [('S' + 'I') & (COMMAND_HASH_SIZE - 1)] = &command_names[COMMAND_SINK],
+    [('L' + 'O') & (COMMAND_HASH_SIZE - 1)] = &command_names[COMMAND_LOGLEVEL],
+};
+
+static long
+command_echo(ServerState *state, SessionDescriptor *session, const uint8_t *args, size_t len, uint8_t *out, size_t cap, const uint8_t **reply)
+{
+    (void)state;
+    (void)session;
+    (void)out;
+    (void)cap;
+    *reply = args;                                                              // 입력 버퍼를 그대로 응답 (복사 없음)
+    return (long)len;
+}
+static long
+command_stats(ServerState *state, SessionDescriptor *session, const uint8_t *args, size_t len, uint8_t *out, size_t cap, const uint8_t **reply)
+{
+    (void)state;
+    (void)args;
+    (void)len;
+    const unsigned long *c = session->command_counts;
+    int n = snprintf((char *)out, cap,
+                     "STATS session=%d pid=%d io=%d uptime=%lds wire_in=%lu wire_out=%lu heap=%ld "
+                     "echo=%lu stats=%lu upper=%lu sleep=%lu discard=%lu sink=%lu loglevel=%lu sunk=%lu\n",
+                     session->session_id, getpid(), session->io_count, (long)(time(NULL) - session->start_time),
+                     session->wire_in, session->wire_out, get_heap_usage(),
+                     c[COMMAND_ECHO], c[COMMAND_STATS], c[COMMAND_UPPER], c[COMMAND_SLEEP], c[COMMAND_DISCARD], c[COMMAND_SINK],
+                     c[COMMAND_LOGLEVEL], session->sunk_bytes);
+    *reply = out;
+    return n < 0 ? -1 : (long)((size_t)n < cap ? (size_t)n : cap - 1);
+}
+static long
+command_upper(ServerState *state, SessionDescriptor *session, const uint8_t *args, size_t len, uint8_t *out, size_t cap, const uint8_t **reply)
+{
+    (void)state;
+    (void)session;
+    if (len > cap)
+        len = cap;
+    for (size_t i = 0; i < len; i++)                                            // 바이트당 CPU 비용이 있는 변환 작업
+        out[i] = (args[i] >= 'a' && args[i] <= 'z') ? (uint8_t)(args[i] - 'a' + 'A') : args[i];
+    *reply = out;
+    return (long)len;
+}
+static long
+command_sleep(ServerState *state, SessionDescriptor *session, const uint8_t *args, size_t len, uint8_t *out, size_t cap, const uint8_t **reply)
+{
+    (void)state;
+    long ms = 0;
+    for (size_t i = 0; i < len && args[i] >= '0' && args[i] <= '9'; i++)       // SLEEP <ms>: 서버 측 지연(블로킹 백엔드 호출) 흉내
+        ms = ms * 10 + (args[i] - '0');
+    if (ms > COMMAND_SLEEP_MAX_MS)
+        ms = COMMAND_SLEEP_MAX_MS;
+    struct timespec ts = {.tv_sec = ms / 1000, .tv_nsec = (ms % 1000) * 1000000L};
+    while (nanosleep(&ts, &ts) == -1 && errno == EINTR && state->running)
+        ;
+    int n = snprintf((char *)out, cap, "SLEEP %ld ms (session %d)\n", ms, session->session_id);
+    *reply = out;
+    return n < 0 ? -1 : (long)((size_t)n < cap ? (size_t)n : cap - 1);
+}
+static long
+command_discard(ServerState *state, SessionDescriptor *session, const uint8_t *args, size_t len, uint8_t *out, size_t cap, const uint8_t **reply)
+{
+    (void)state;
+    (void)session;
+    (void)args;
+    (void)len;
+    (void)out;
+    (void)cap;
+    *reply = NULL;                                                              // 응답 없음: 수신 경로 비용만 측정
+    return 0;
+}
+static long
+command_sink(ServerState *state, SessionDescriptor *session, const uint8_t *args, size_t len, uint8_t *out, size_t cap, const uint8_t **reply)
+{
+    (void)state;
+    (void)args;
+    session->sunk_bytes += len;                                                 // 받은 양만 짧게 확인 응답 (대량 업로드 시나리오)
+    int n = snprintf((char *)out, cap, "SINK %zu bytes (total %lu)\n", len, session->sunk_bytes);
+    *reply = out;
+    return n < 0 ? -1 : (long)((size_t)n < cap ? (size_t)n : cap - 1);
+}
+static long
+command_loglevel(ServerState *state, SessionDescriptor *session, const uint8_t *args, size_t len, uint8_t *out, size_t cap, const uint8_t **reply)
+{
+    char spec[256], current[128];
+    int n;
+    while (len > 0 && (args[len - 1] == '\n' || args[len - 1] == '\r'))
+        len--;
+    if (session->addr.sin_addr.s_addr != htonl(INADDR_LOOPBACK))             // 관리 명령: 같은 호스트에서만
+        n = snprintf((char *)out, cap, "LOGLEVEL ERR loopback only\n");
+    else if (len >= sizeof(spec))
+        n = snprintf((char *)out, cap, "LOGLEVEL ERR too long\n");
+    else
+    {
+        memcpy(spec, args, len);
+        spec[len] = '\0';
+        if (len > 0 && log_levels_apply(spec) < 0)                             // 공유 메모리의 레벨 표: 부모와 모든 Worker에 즉시 반영
+            n = snprintf((char *)out, cap, "LOGLEVEL ERR usage: LOGLEVEL [module=level ...] (module: all/core/accept/worker/shutdown/monitor)\n");
+        else
+        {
+            log_levels_format(current, sizeof(current));
+            if (len > 0)
+                log_message(state, LOG_WARNING, "로그 레벨 변경 (Session #%d): %s", session->session_id, current);
+            n = snprintf((char *)out, cap, "LOGLEVEL %s\n", current);
+        }
+    }
+    *reply = out;
+    return n < 0 ? -1 : (long)((size_t)n < cap ? (size_t)n : cap - 1);
+}
+const CommandEntry *
+command_lookup(const uint8_t *token, size_t len)
+{
+    if (len < 2 || len > COMMAND_TOKEN_MAX)
+        return NULL;
+    const CommandEntry *entry = command_table[(token[0] + token[1]) & (COMMAND_HASH_SIZE - 1)];   // 해시 1번 + 비교 1번
+    if (entry == NULL || entry->name_len != len || memcmp(entry->name, token, len) != 0)
+        return NULL;
+    return entry;
+}
+long
+command_dispatch(ServerState *state, SessionDescriptor *session, const uint8_t *input, size_t len, uint8_t *out, size_t cap, const uint8_t **reply)
+{
+    size_t token_len = 0;
+    while (token_len < len && input[token_len] != ' ' && input[token_len] != '\n' && input[token_len] != '\r')
+        token_len++;
+    const CommandEntry *entry = command_lookup(input, token_len);
+    if (entry == NULL)                                                          // 명령이 아니면 기존처럼 전체를 에코
+    {
+        session->command_counts[COMMAND_ECHO]++;
+        return command_echo(state, session, input, len, out, cap, reply);
+    }
+    size_t skip = token_len < len && input[token_len] == ' ' ? token_len + 1 : token_len;   // 명령 뒤 공백 1개까지가 명령 부분
+    session->command_counts[entry->id]++;
+    return entry->handler(state, session, input + skip, len - skip, out, cap, reply);
+}
+const char *
+command_name(CommandId id)
+{
+    return id < COMMAND_COUNT ? command_names[id].name : "UNKNOWN";
+}
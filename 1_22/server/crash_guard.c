@@ -0,0 +1,171 @@
+#define LOG_MODULE LOG_MODULE_ACCEPT
+#include "server_function.h"
+
+static const char *const crash_kind_names[CRASH_KIND_COUNT] = {"SIGSEGV", "SIGABRT", "SIGBUS", "SIGFPE", "기타 시그널", "exec 실패"};
+
+int
+crash_guard_init(ServerState *state)
+{
+    state->crash_guard = calloc(1, sizeof(CrashGuard));                         // 부모 전용 (Worker는 사용 안 함)
+    if (state->crash_guard == NULL)
+    {
+        log_message(state, LOG_ERROR, "crash_guard_init() : calloc() 실패");
+        return -1;
+    }
+    return 0;
+}
+void
+crash_guard_destroy(ServerState *state)
+{
+    free(state->crash_guard);
+    state->crash_guard = NULL;
+}
+static int
+crash_classify(int status)
+{
+    if (WIFEXITED(status))
+        return WEXITSTATUS(status) == 127 ? CRASH_EXEC : -1;                   // 127: execvp 실패 (worker 실행파일 문제)
+    if (!WIFSIGNALED(status))
+        return -1;
+    switch (WTERMSIG(status))
+    {
+    case SIGSEGV: return CRASH_SEGV;
+    case SIGABRT: return CRASH_ABRT;
+    case SIGBUS:  return CRASH_BUS;
+    case SIGFPE:  return CRASH_FPE;
+    case SIGTERM:
+    case SIGKILL:
+    case SIGINT:  return -1;                                                    // 종료 절차에 의한 정상 종료
+    default:      return CRASH_OTHER;
+    }
+}
+static CrashIpEntry *
+crash_ip_entry(CrashGuard *guard, uint32_t ip, time_t now)
+{
+    uint32_t i = (ip * 2654435761u) >> (32 - CRASH_IP_TABLE_BITS);
+    CrashIpEntry *stale = NULL;
+    for (int n = 0; n < CRASH_IP_TABLE_SIZE; n++, i = (i + 1) & (CRASH_IP_TABLE_SIZE - 1))
+    {
+        CrashIpEntry *entry = &guard->ips[i];
+        if (entry->crashes == 0 && entry->quarantine_until == 0)                // 빈 칸: 체인 끝
+        {
+            if (stale == NULL)
+                stale = entry;
+            break;
+        }
+        if (entry->ip == ip)
+            return entry;
+        if (stale == NULL && entry->window_start + CRASH_IP_WINDOW < now && entry->quarantine_until < now)   // 만료된 항목은 재사용 후보
+            stale = entry;
+    }
+    if (stale != NULL)
+    {
+        memset(stale, 0, sizeof(*stale));
+        stale->ip = ip;
+    }
+    return stale;                                                               // NULL: 테이블 포화, 이 IP는 추적 생략
+}
+int
+crash_guard_record(ServerState *state, const WorkerRecord *info, int status)
+{
+    CrashGuard *guard = state->crash_guard;
+    int kind = crash_classify(status);
+    if (guard == NULL || kind < 0)
+        return 0;
+    uint64_t now_ms = timer_wheel_clock_ms();
+    time_t now = time(NULL);
+    guard->crashes++;
+    guard->by_kind[kind]++;
+    char ip[INET_ADDRSTRLEN];
+    inet_ntop(AF_INET, &info->addr.sin_addr, ip, sizeof(ip));
+    log_message(state, LOG_WARNING, "crash_guard_record() : Worker PID %d 비정상 종료 (%s, Session #%d, %s, %.1f초 실행)",
+                info->pid, crash_kind_names[kind], info->session_id, ip, (now_ms - info->spawn_ms) / 1000.0);
+    CrashIpEntry *entry = crash_ip_entry(guard, info->addr.sin_addr.s_addr, now);
+    if (entry != NULL)
+    {
+        if (entry->window_start + CRASH_IP_WINDOW < now)                        // 창이 지나면 카운트 초기화
+        {
+            entry->window_start = now;
+            entry->crashes = 0;
+        }
+        entry->crashes++;
+        if (entry->crashes >= CRASH_IP_THRESHOLD && entry->quarantine_until < now)
+        {
+            int shift = entry->offenses < 5 ? entry->offenses : 5;
+            long seconds = (long)CRASH_QUARANTINE_SEC << shift;                 // 반복 위반마다 격리 시간 2배
+            if (seconds > CRASH_QUARANTINE_MAX)
+                seconds = CRASH_QUARANTINE_MAX;
+            entry->quarantine_until = now + seconds;
+            entry->offenses++;
+            entry->crashes = 0;
+            guard->quarantines++;
+            log_message(state, LOG_WARNING, "crash_guard_record() : %s 격리 %ld초 (%d초 내 크래시 %d회, 위반 %d번째)",
+                        ip, seconds, CRASH_IP_WINDOW, CRASH_IP_THRESHOLD, entry->offenses);
+        }
+    }
+    if (guard->last_crash_ms + CRASH_STORM_WINDOW_MS < now_ms)                 // 조용한 구간이 지나면 백오프 단계 초기화
+        guard->backoff_level = 0;
+    guard->last_crash_ms = now_ms;
+    uint64_t oldest = guard->recent[guard->recent_pos];                         // 최근 CRASH_STORM_THRESHOLD건 중 가장 오래된 시각
+    guard->recent[guard->recent_pos] = now_ms;
+    guard->recent_pos = (guard->recent_pos + 1) % CRASH_STORM_THRESHOLD;
+    if (oldest != 0 && now_ms - oldest <= CRASH_STORM_WINDOW_MS && now_ms >= guard->backoff_until_ms)
+    {
+        int shift = guard->backoff_level < 16 ? guard->backoff_level : 16;
+        uint64_t delay = (uint64_t)CRASH_BACKOFF_BASE_MS << shift;             // 지수 백오프: 폭주가 이어질수록 accept 중단 시간 증가
+        if (delay > CRASH_BACKOFF_MAX_MS)
+            delay = CRASH_BACKOFF_MAX_MS;
+        guard->backoff_level++;
+        guard->backoff_until_ms = now_ms + delay;
+        guard->backoffs++;
+        guard->backoff_total_ms += delay;
+        log_message(state, LOG_WARNING, "crash_guard_record() : 크래시 폭주 감지 (%.1f초 내 %d회), accept %llu ms 중단 (단계 %d)",
+                    (now_ms - oldest) / 1000.0, CRASH_STORM_THRESHOLD, (unsigned long long)delay, guard->backoff_level);
+    }
+    return 1;
+}
+int
+crash_guard_admit(ServerState *state, const struct sockaddr_in *addr)
+{
+    CrashGuard *guard = state->crash_guard;
+    if (guard == NULL || guard->quarantines == 0)                               // 격리 이력이 없으면 조회 생략
+        return 0;
+    uint32_t ip = addr->sin_addr.s_addr;
+    uint32_t i = (ip * 2654435761u) >> (32 - CRASH_IP_TABLE_BITS);
+    time_t now = time(NULL);
+    for (int n = 0; n < CRASH_IP_TABLE_SIZE; n++, i = (i + 1) & (CRASH_IP_TABLE_SIZE - 1))
+    {
+        CrashIpEntry *entry = &guard->ips[i];
+        if (entry->crashes == 0 && entry->quarantine_until == 0)
+            return 0;
+        if (entry->ip == ip)
+        {
+            if (entry->quarantine_until <= now)
+                return 0;
+            guard->rejected++;
+            return -1;
+        }
+    }
+    return 0;
+}
+long
+crash_guard_backoff_ms(ServerState *state)
+{
+    CrashGuard *guard = state->crash_guard;
+    if (guard == NULL || guard->backoff_until_ms == 0)
+        return 0;
+    uint64_t now_ms = timer_wheel_clock_ms();
+    return guard->backoff_until_ms > now_ms ? (long)(guard->backoff_until_ms - now_ms) : 0;
+}
+void
+crash_guard_report(ServerState *state)
+{
+    CrashGuard *guard = state->crash_guard;
+    if (guard == NULL || guard->crashes == 0)
+        return;
+    log_message(state, LOG_INFO, "크래시 통계: 총 %lu회 (SIGSEGV %lu, SIGABRT %lu, SIGBUS %lu, SIGFPE %lu, 기타 %lu, exec 실패 %lu)",
+                guard->crashes, guard->by_kind[CRASH_SEGV], guard->by_kind[CRASH_ABRT], guard->by_kind[CRASH_BUS],
+                guard->by_kind[CRASH_FPE], guard->by_kind[CRASH_OTHER], guard->by_kind[CRASH_EXEC]);
+    log_message(state, LOG_INFO, "크래시 대응: IP 격리 %lu회, 격리로 거부한 연결 %lu개, accept 백오프 %lu회 (총 %.1f초)",
+                guard->quarantines, guard->rejected, guard->backoffs, guard->backoff_total_ms / 1000.0);
+}
@@ -0,0 +1,213 @@
+#define _GNU_SOURCE
+#include "server_function.h"
+#include <execinfo.h>
+#include <fcntl.h>
+#include <link.h>
+#include <sys/mman.h>
+
+static CrashRing *crash_ring = NULL;                                            // 핸들러에서 쓰므로 전역 (시그널 안전)
+static uintptr_t crash_load_bias = 0;
+static uint64_t crash_image_size = 0;
+
+static int
+crash_ring_find_bias(struct dl_phdr_info *info, size_t size, void *arg)
+{
+    (void)size;
+    (void)arg;
+    crash_load_bias = (uintptr_t)info->dlpi_addr;                               // 첫 항목 = 실행 파일 (PIE 로드 오프셋)
+    for (int i = 0; i < info->dlpi_phnum; i++)
+    {
+        const ElfW(Phdr) *phdr = &info->dlpi_phdr[i];
+        if (phdr->p_type == PT_LOAD && phdr->p_vaddr + phdr->p_memsz > crash_image_size)
+            crash_image_size = phdr->p_vaddr + phdr->p_memsz;                   // 이 범위 밖 프레임은 libc 등 (ASLR로 프로세스마다 다름)
+    }
+    return 1;
+}
+static CrashRing *
+crash_ring_map(ServerState *state, pid_t owner, int create)
+{
+    char name[64];
+    snprintf(name, sizeof(name), CRASH_RING_SHM_FMT, (int)owner);
+    int fd = shm_open(name, create ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDWR, 0600);
+    if (fd == -1)
+    {
+        log_message(state, LOG_ERROR, "crash_ring_map() : shm_open(%s) 실패: %s", name, strerror(errno));
+        return NULL;
+    }
+    if (create && ftruncate(fd, sizeof(CrashRing)) == -1)
+    {
+        log_message(state, LOG_ERROR, "crash_ring_map() : ftruncate() 실패: %s", strerror(errno));
+        close(fd);
+        return NULL;
+    }
+    CrashRing *ring = mmap(NULL, sizeof(CrashRing), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (ring == MAP_FAILED)
+    {
+        log_message(state, LOG_ERROR, "crash_ring_map() : mmap() 실패: %s", strerror(errno));
+        return NULL;
+    }
+    return ring;
+}
+int
+crash_ring_create(ServerState *state)
+{
+    state->crash_ring = crash_ring_map(state, getpid(), 1);                     // 부모: 링 생성, 회수 시 읽기
+    return state->crash_ring ? 0 : -1;
+}
+int
+crash_ring_attach(ServerState *state)
+{
+    state->crash_ring = crash_ring_map(state, getppid(), 0);
+    if (state->crash_ring == NULL)
+        return -1;
+    void *warmup[2];
+    backtrace(warmup, 2);                                                       // libgcc를 미리 로드: 핸들러 안에서 malloc/dlopen 방지
+    dl_iterate_phdr(crash_ring_find_bias, NULL);
+    crash_ring = state->crash_ring;
+    return 0;
+}
+void
+crash_ring_destroy(ServerState *state)
+{
+    if (state->crash_ring == NULL)
+        return;
+    munmap(state->crash_ring, sizeof(CrashRing));
+    state->crash_ring = NULL;
+    crash_ring = NULL;
+    if (getpid() == state->parent_pid)
+    {
+        char name[64];
+        snprintf(name, sizeof(name), CRASH_RING_SHM_FMT, (int)getpid());
+        shm_unlink(name);
+    }
+}
+int
+crash_ring_write(int signo, const siginfo_t *info, int session_id)
+{
+    CrashRing *ring = crash_ring;
+    if (ring == NULL)
+        return -1;
+    uint32_t seq = atomic_fetch_add(&ring->head, 1);                            // 슬롯 예약 (lock-free, 시그널 안전)
+    CrashRecord *rec = &ring->records[seq % CRASH_RING_SIZE];
+    rec->pid = getpid();                                                        // 기록 중 표시보다 먼저: 도중에 죽으면 부모가 이 PID로 판별
+    atomic_store_explicit(&rec->seq, 0, memory_order_release);                  // 기록 중 표시
+    rec->session_id = session_id;
+    rec->signo = signo;
+    rec->code = info ? info->si_code : 0;
+    rec->fault_addr = info ? (uint64_t)(uintptr_t)info->si_addr : 0;
+    rec->load_bias = crash_load_bias;
+    rec->image_size = crash_image_size;
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    rec->time_ms = (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+    void *frames[CRASH_RECORD_FRAMES];
+    int n = backtrace(frames, CRASH_RECORD_FRAMES);                             // 주소만 수집, 심볼화는 부모가 나중에
+    rec->nframes = n > 0 ? n : 0;
+    for (int i = 0; i < (int)rec->nframes; i++)
+        rec->frames[i] = (uint64_t)(uintptr_t)frames[i];
+    atomic_store_explicit(&rec->seq, seq + 1, memory_order_release);            // 완료 표시: 부모는 seq가 맞을 때만 읽음
+    return 0;
+}
+static uint64_t
+crash_stack_hash(const CrashRecord *rec)
+{
+    uint64_t hash = 1469598103934665603ULL;                                     // FNV-1a, 로드 오프셋을 뺀 주소 기준 (ASLR 무관)
+    for (uint32_t i = 0; i < rec->nframes; i++)
+    {
+        uint64_t offset = rec->frames[i] - rec->load_bias;
+        if (offset >= rec->image_size)                                          // 실행 파일 안의 프레임만 사용
+            continue;
+        for (int b = 0; b < 8; b++)
+        {
+            hash ^= (offset >> (b * 8)) & 0xff;
+            hash *= 1099511628211ULL;
+        }
+    }
+    return hash;
+}
+void
+crash_ring_drain(ServerState *state)
+{
+    CrashRing *ring = state->crash_ring;
+    CrashGuard *guard = state->crash_guard;
+    if (ring == NULL || guard == NULL)
+        return;
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    if (head - guard->ring_tail > CRASH_RING_SIZE)                              // 부모가 읽기 전에 덮어써짐
+    {
+        guard->ring_lost += head - guard->ring_tail - CRASH_RING_SIZE;
+        guard->ring_tail = head - CRASH_RING_SIZE;
+    }
+    for (; guard->ring_tail != head; guard->ring_tail++)
+    {
+        const CrashRecord *rec = &ring->records[guard->ring_tail % CRASH_RING_SIZE];
+        uint32_t seq = atomic_load_explicit(&rec->seq, memory_order_acquire);
+        if (seq == 0 && rec->pid > 0 && kill(rec->pid, 0) == -1 && errno == ESRCH)
+        {
+            guard->ring_lost++;                                                 // 기록 도중 죽고 이미 회수된 Worker: 건너뛰지 않으면 이후 기록이 모두 막힘
+            log_message(state, LOG_WARNING, "crash_ring_drain() : PID %d가 기록을 마치지 못하고 종료, 슬롯 건너뜀", rec->pid);
+            continue;
+        }
+        if (seq != guard->ring_tail + 1)
+            break;                                                              // 아직 기록 중: 다음 회수 때 다시 읽음
+        uint64_t hash = crash_stack_hash(rec);
+        CrashStack *stack = NULL;
+        for (int i = 0; i < guard->stack_count && stack == NULL; i++)
+            if (guard->stacks[i].hash == hash)
+                stack = &guard->stacks[i];
+        if (stack == NULL && guard->stack_count < CRASH_STACKS_MAX)
+        {
+            stack = &guard->stacks[guard->stack_count++];
+            stack->hash = hash;
+            memcpy(&stack->sample, rec, sizeof(CrashRecord));                   // 심볼화용 대표 기록
+        }
+        if (stack != NULL)
+            stack->count++;
+        log_message(state, LOG_WARNING, "크래시 기록: PID %d, Session #%d, %s (code %d), 주소 0x%llx, 프레임 %u, 스택 %016llx",
+                    rec->pid, rec->session_id, strsignal(rec->signo), rec->code, (unsigned long long)rec->fault_addr,
+                    rec->nframes, (unsigned long long)hash);
+    }
+}
+static void
+crash_stack_symbolize(ServerState *state, const CrashRecord *rec)
+{
+    char cmd[64 + CRASH_RECORD_FRAMES * 20];
+    int len = snprintf(cmd, sizeof(cmd), "addr2line -f -C -p -e %s", CRASH_WORKER_BINARY);
+    for (uint32_t i = 0; i < rec->nframes && len < (int)sizeof(cmd) - 20; i++)
+        len += snprintf(cmd + len, sizeof(cmd) - len, " 0x%llx", (unsigned long long)(rec->frames[i] - rec->load_bias - (i > 0)));   // 복귀 주소 → 호출 지점
+    FILE *fp = popen(cmd, "r");
+    char line[512];
+    int frame = 0;
+    if (fp != NULL)
+    {
+        while (fgets(line, sizeof(line), fp) != NULL)
+        {
+            line[strcspn(line, "\n")] = '\0';
+            log_message(state, LOG_INFO, "    #%-2d %s", frame++, line);
+        }
+        pclose(fp);
+    }
+    for (; frame < (int)rec->nframes; frame++)                                  // addr2line이 없으면 오프셋만 출력
+        log_message(state, LOG_INFO, "    #%-2d +0x%llx", frame, (unsigned long long)(rec->frames[frame] - rec->load_bias));
+}
+void
+crash_ring_report(ServerState *state)
+{
+    CrashGuard *guard = state->crash_guard;
+    if (guard == NULL)
+        return;
+    crash_ring_drain(state);
+    if (guard->stack_count == 0)
+        return;
+    log_message(state, LOG_INFO, "크래시 스택별 집계: %d종류%s", guard->stack_count, guard->ring_lost ? " (덮어쓰기 또는 미완료로 일부 유실)" : "");
+    if (guard->ring_lost)
+        log_message(state, LOG_WARNING, "crash_ring_report() : 유실된 크래시 기록 %lu건", guard->ring_lost);
+    for (int i = 0; i < guard->stack_count; i++)
+    {
+        const CrashStack *stack = &guard->stacks[i];
+        log_message(state, LOG_INFO, "  스택 %016llx: %lu회, %s, 예: PID %d Session #%d", (unsigned long long)stack->hash, stack->count,
+                    strsignal(stack->sample.signo), stack->sample.pid, stack->sample.session_id);
+        crash_stack_symbolize(state, &stack->sample);
+    }
+}
@@ -0,0 +1,116 @@
+#include "server_function.h"
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#endif
+
+#define CRC32C_POLY 0x82F63B78u                                                 // Castagnoli 다항식 (reflected)
+
+static uint32_t crc32c_table[8][256];
+static uint32_t (*crc32c_impl)(uint32_t crc, const uint8_t *data, size_t len) = NULL;
+
+static uint32_t
+crc32c_portable(uint32_t crc, const uint8_t *data, size_t len)
+{
+    while (len >= 8)                                                            // slicing-by-8: 8바이트씩 테이블 8개로 처리
+    {
+        uint32_t lo = crc ^ ((uint32_t)data[0] | (uint32_t)data[1] << 8 | (uint32_t)data[2] << 16 | (uint32_t)data[3] << 24);
+        uint32_t hi = (uint32_t)data[4] | (uint32_t)data[5] << 8 | (uint32_t)data[6] << 16 | (uint32_t)data[7] << 24;
+        crc = crc32c_table[7][lo & 0xff] ^ crc32c_table[6][(lo >> 8) & 0xff] ^
+              crc32c_table[5][(lo >> 16) & 0xff] ^ crc32c_table[4][lo >> 24] ^
+              crc32c_table[3][hi & 0xff] ^ crc32c_table[2][(hi >> 8) & 0xff] ^
+              crc32c_table[1][(hi >> 16) & 0xff] ^ crc32c_table[0][hi >> 24];
+        data += 8;
+        len -= 8;
+    }
+    while (len--)
+        crc = crc32c_table[0][(crc ^ *data++) & 0xff] ^ (crc >> 8);
+    return crc;
+}
+#if defined(__x86_64__)
+__attribute__((target("sse4.2")))
+static uint32_t
+crc32c_sse42(uint32_t crc, const uint8_t *data, size_t len)
+{
+    uint64_t crc64 = crc;
+    while (len > 0 && ((uintptr_t)data & 7) != 0)                               // 8바이트 정렬까지 1바이트씩
+    {
+        crc64 = _mm_crc32_u8((uint32_t)crc64, *data++);
+        len--;
+    }
+    while (len >= 8)                                                            // crc32 명령어 1개로 8바이트 처리
+    {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+        data += 8;
+        len -= 8;
+    }
+    while (len--)
+        crc64 = _mm_crc32_u8((uint32_t)crc64, *data++);
+    return (uint32_t)crc64;
+}
+#endif
+void
+crc32c_init(void)
+{
+    for (uint32_t i = 0; i < 256; i++)                                          // 기본 테이블 생성
+    {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; bit++)
+            crc = (crc & 1) ? (crc >> 1) ^ CRC32C_POLY : crc >> 1;
+        crc32c_table[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; i++)                                          // slicing용 파생 테이블
+    {
+        for (int t = 1; t < 8; t++)
+            crc32c_table[t][i] = (crc32c_table[t - 1][i] >> 8) ^ crc32c_table[0][crc32c_table[t - 1][i] & 0xff];
+    }
+    crc32c_impl = crc32c_portable;
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.2"))                                       // 런타임 CPU 기능 확인 후 하드웨어 경로 선택
+        crc32c_impl = crc32c_sse42;
+#endif
+}
+int
+crc32c_select(const char *name)
+{
+    if (crc32c_impl == NULL)
+        crc32c_init();
+    if (strcmp(name, "portable") == 0)                                          // 벤치마크/검증용: 하드웨어가 있어도 테이블 경로 사용
+    {
+        crc32c_impl = crc32c_portable;
+        return 0;
+    }
+#if defined(__x86_64__)
+    if (strcmp(name, "sse4.2") == 0 && __builtin_cpu_supports("sse4.2"))
+    {
+        crc32c_impl = crc32c_sse42;
+        return 0;
+    }
+#endif
+    return -1;
+}
+const char *
+crc32c_impl_name(void)
+{
+    if (crc32c_impl == NULL)
+        crc32c_init();
+#if defined(__x86_64__)
+    if (crc32c_impl == crc32c_sse42)
+        return "sse4.2";
+#endif
+    return "portable";
+}
+uint32_t
+crc32c_update(uint32_t crc, const void *data, size_t len)
+{
+    if (crc32c_impl == NULL)
+        crc32c_init();
+    return ~crc32c_impl(~crc, (const uint8_t *)data, len);                      // 표준 CRC32C: 초기값/최종값 반전
+}
+uint32_t
+crc32c(const void *data, size_t len)
+{
+    return crc32c_update(0, data, len);
+}
@@ -0,0 +1,102 @@
+#define _DEFAULT_SOURCE
+#include "server_function.h"
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+#define CRCBENCH_MAX_SIZE (1024 * 1024)
+#define CRCBENCH_ROUNDS 5
+
+static uint64_t
+crcbench_ticks(void)
+{
+#if defined(__x86_64__)
+    return __rdtsc();                                                           // TSC 기준 (cycles/byte)
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;          // TSC가 없으면 ns/byte
+#endif
+}
+static volatile uint32_t crcbench_sink;                                        // 결과를 쓰게 해 계산이 제거되지 않도록
+
+static double
+crcbench_run(const uint8_t *data, size_t size, size_t total)
+{
+    size_t reps = total / size > 0 ? total / size : 1;
+    double best = 0;
+    uint32_t crc = 0;
+    for (int round = 0; round < CRCBENCH_ROUNDS; round++)                       // 가장 빠른 회차: 인터럽트/주파수 변동 제외
+    {
+        uint64_t t0 = crcbench_ticks();
+        for (size_t r = 0; r < reps; r++)
+            crc ^= crc32c(data, size);
+        uint64_t t1 = crcbench_ticks();
+        double per_byte = (double)(t1 - t0) / ((double)reps * size);
+        if (round == 0 || per_byte < best)
+            best = per_byte;
+    }
+    crcbench_sink = crc;
+    return best;
+}
+int
+main(int argc, char *argv[])
+{
+    static const char *const impls[] = {"sse4.2", "portable"};
+    size_t total = 64UL * 1024 * 1024;
+    int opt;
+    while ((opt = getopt(argc, argv, "m:")) != -1)
+    {
+        if (opt == 'm' && atol(optarg) > 0)
+            total = (size_t)atol(optarg) * 1024 * 1024;
+        else
+        {
+            fprintf(stderr, "사용법: %s [-m 크기별 처리량(MiB)]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    uint8_t *data = malloc(CRCBENCH_MAX_SIZE);
+    if (data == NULL)
+        return EXIT_FAILURE;
+    for (size_t i = 0; i < CRCBENCH_MAX_SIZE; i++)
+        data[i] = (uint8_t)(i * 2654435761u >> 24);
+#if defined(__x86_64__)
+    const char *unit = "cycles/byte";
+#else
+    const char *unit = "ns/byte";
+#endif
+    printf("%10s", "SIZE");
+    for (size_t i = 0; i < sizeof(impls) / sizeof(impls[0]); i++)
+        printf(" %12s", impls[i]);
+    printf("   (%s, %d회 중 최소)\n", unit, CRCBENCH_ROUNDS);
+    int mismatch = 0;
+    for (size_t size = 64; size <= CRCBENCH_MAX_SIZE; size *= 4)                 // 64 B .. 1 MiB (프레임 최대 16 KiB 포함)
+    {
+        printf("%10zu", size);
+        uint32_t expect = 0;
+        int have_expect = 0;
+        for (size_t i = 0; i < sizeof(impls) / sizeof(impls[0]); i++)
+        {
+            if (crc32c_select(impls[i]) == -1)
+            {
+                printf(" %12s", "-");
+                continue;
+            }
+            double per_byte = crcbench_run(data, size, total);
+            uint32_t crc = crc32c(data, size);
+            if (have_expect && crc != expect)
+                mismatch = 1;                                                   // 구현 간 결과가 다르면 실패
+            expect = crc;
+            have_expect = 1;
+            printf(" %12.3f", per_byte);
+        }
+        printf("\n");
+    }
+    free(data);
+    if (mismatch)
+    {
+        fprintf(stderr, "main() : 구현 간 CRC32C 불일치\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -1,8 +1,9 @@
+#define LOG_MODULE LOG_MODULE_WORKER
 #include "server_function.h"
 #include <fcntl.h>
 
 int 
-fork_and_exec_worker(int serv_sock, int clnt_sock, int session_id, struct sockaddr_in *clnt_addr, ServerState *state)
+fork_and_exec_worker(int serv_sock, int clnt_sock, int session_id, struct sockaddr_in *clnt_addr, uint64_t accept_us, ServerState *state)
 {
     pid_t pid;
     char session_str[32], ip_str[INET_ADDRSTRLEN], port_str[32];
@@ -16,15 +17,34 @@ fork_and_exec_worker(int serv_sock, int clnt_sock, int session_id, struct sockad
         log_message(state, LOG_ERROR, "fork_and_exec_worker() : inet_ntop() 실패: %s", strerror(errno));
         return -1;
     }
+    int backend = -1;
+    if (state->proxy)                                                           // 프록시 모드: fork 전에 백엔드 선택
+    {
+        backend = proxy_pick_backend(state, clnt_addr);
+        if (backend == -1)
+        {
+            log_message(state, LOG_WARNING, "fork_and_exec_worker() : 사용 가능한 백엔드 없음, 연결 거부");
+            return -1;
+        }
+    }
+    int record = worker_registry_reserve(state, session_id, clnt_addr, backend);   // 메타데이터는 fork 전에 기록
+    if (record == -1)
+    {
+        log_message(state, LOG_WARNING, "fork_and_exec_worker() : Worker 레코드 부족, 연결 거부");
+        return -1;
+    }
     pid = fork();
     if (pid == -1) 
     {
         log_message(state, LOG_ERROR, "fork_and_exec_worker() : fork() 실패: %s", strerror(errno));
+        worker_registry_cancel(state, record);
         return -1;
     } 
     else if (pid == 0) 
     { 
         close(serv_sock);
+        if (state->signal_fd != -1)                                             // 차단 마스크는 exec 후에도 유지되므로 원래대로 복구
+            sigprocmask(SIG_SETMASK, &state->saved_sigmask, NULL);
         if (dup2(clnt_sock, 3) == -1) 
         {
             fprintf(stderr, "fork_and_exec_worker() : [자식 #%d] dup2() 실패: %s\n", session_id, strerror(errno));
@@ -32,6 +52,16 @@ fork_and_exec_worker(int serv_sock, int clnt_sock, int session_id, struct sockad
         }
         if (clnt_sock != 3)
             close(clnt_sock);
+        if (backend >= 0 && setenv(PROXY_BACKEND_ENV, state->proxy->backends[backend].name, 1) == -1)
+            _exit(1);
+        char record_str[16];
+        snprintf(record_str, sizeof(record_str), "%d", record);
+        if (setenv(WORKER_SLOT_ENV, record_str, 1) == -1)
+            _exit(1);
+        char accept_str[32];
+        snprintf(accept_str, sizeof(accept_str), "%llu", (unsigned long long)accept_us);
+        if (backend < 0 && setenv(START_ACCEPT_ENV, accept_str, 1) == -1)     // 첫 에코까지의 지연 측정 기준 시각
+            _exit(1);
         snprintf(session_str, sizeof(session_str), "%d", session_id);
         snprintf(port_str, sizeof(port_str), "%d", ntohs(clnt_addr->sin_port));
         char *const argv[] = {(char*)"./worker", session_str, ip_str, port_str, NULL};
@@ -43,6 +73,9 @@ fork_and_exec_worker(int serv_sock, int clnt_sock, int session_id, struct sockad
     }
     state->total_forks++;
     state->worker_count++;
+    worker_registry_commit(state, record, pid);
+    if (backend >= 0)
+        proxy_track_worker(state, backend);
     close(clnt_sock);
     log_message(state, LOG_INFO, "fork_and_exec_worker() : Worker 프로세스 생성 (PID: %d, Session #%d)", pid, session_id);
     return 0;
@@ -55,13 +88,28 @@ handle_child_died(ServerState *state)
     state->child_died = 0;
     pid_t pid;
     int status;
-    int reaped = 0;
+    int reaped = 0, crashed = 0;
+    WorkerRecord info;
     while ((pid = waitpid(-1, &status, WNOHANG)) > 0) 
     {
+        if (worker_registry_remove(state, pid, &info) == -1)                   // O(1): PID → 레코드
+        {
+            log_message(state, LOG_DEBUG, "handle_child_died() : Worker가 아닌 자식 PID %d 회수 (로그 압축 등), 집계 제외", pid);
+            continue;
+        }
         state->zombie_reaped++;
         state->worker_count--;
+        proxy_worker_exited(state, info.backend);
+        crashed += crash_guard_record(state, &info, status);                   // 시그널/exec 실패 종료면 크래시로 집계
+        log_message(state, LOG_DEBUG, "handle_child_died() : Worker PID %d 종료 (Session #%d, %.1f초, I/O %u, in %llu / out %llu bytes)",
+                    pid, info.session_id, (timer_wheel_clock_ms() - info.spawn_ms) / 1000.0, info.io_count,
+                    (unsigned long long)info.bytes_in, (unsigned long long)info.bytes_out);
+        worker_pool_exited(state, pid);
+        pubsub_reap(state, pid);
         reaped++;
     }
+    if (crashed > 0)
+        crash_ring_drain(state);                                                // Worker가 남긴 바이너리 크래시 기록 수거
     if (reaped > 0)
         log_message(state, LOG_DEBUG, "handle_child_died() : 좀비 회수: %d개, 남은 Worker: %d개", state->zombie_reaped, state->worker_count);
 }
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "server_function.h"
+
+static void
+put_be32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+static uint32_t
+get_be32(const uint8_t *p)
+{
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | (uint32_t)p[3];
+}
+long
+frame_parse(const uint8_t *buf, size_t len, FrameHeader *hdr)
+{
+    if (len < FRAME_HEADER_SIZE)                                                // 헤더가 다 오지 않음
+        return 0;
+    if (buf[0] != FRAME_MAGIC)
+        return -1;
+    hdr->type = buf[1];
+    hdr->flags = buf[2];
+    hdr->length = get_be32(buf + 4);
+    if (hdr->length > FRAME_MAX_PAYLOAD)                                        // 길이 필드 손상 또는 과대 프레임
+        return -1;
+    size_t total = FRAME_HEADER_SIZE + hdr->length + ((hdr->flags & FRAME_FLAG_CRC) ? FRAME_CRC_SIZE : 0);
+    if (len < total)                                                            // 페이로드/트레일러가 다 오지 않음
+        return 0;
+    if (hdr->flags & FRAME_FLAG_CRC)                                            // 헤더+페이로드에 대한 CRC32C 검증
+    {
+        uint32_t expected = get_be32(buf + FRAME_HEADER_SIZE + hdr->length);
+        if (crc32c(buf, FRAME_HEADER_SIZE + hdr->length) != expected)
+            return -2;
+    }
+    hdr->payload = buf + FRAME_HEADER_SIZE;
+    return (long)total;
+}
+long
+frame_build(uint8_t *out, size_t cap, uint8_t type, uint8_t flags, const void *payload, uint32_t len)
+{
+    size_t total = FRAME_HEADER_SIZE + len + ((flags & FRAME_FLAG_CRC) ? FRAME_CRC_SIZE : 0);
+    if (len > FRAME_MAX_PAYLOAD || total > cap)
+        return -1;
+    out[0] = FRAME_MAGIC;
+    out[1] = type;
+    out[2] = flags;
+    out[3] = 0;
+    put_be32(out + 4, len);
+    if (len > 0 && payload != out + FRAME_HEADER_SIZE)
+        memmove(out + FRAME_HEADER_SIZE, payload, len);
+    if (flags & FRAME_FLAG_CRC)                                                 // 송신 시 트레일러 계산
+        put_be32(out + FRAME_HEADER_SIZE + len, crc32c(out, FRAME_HEADER_SIZE + len));
+    return (long)total;
+}
@@ -1,67 +1,1074 @@
+#define _GNU_SOURCE
 #include "server_function.h"
 #include <stdarg.h>
 #include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/pidfd.h>
+#include <sys/wait.h>
+#include <strings.h>
 
-static const char* 
+static LogRing *log_ring = NULL;                                        // 부모: 생성 + 기록자, Worker: 부모의 링에 추가만
+static LogWriter log_writer = {.fd = -1};                               // 부모 전용 단일 기록자 (크래시 핸들러에서도 접근)
+static char log_batch[LOG_WRITE_BUF];                                   // 기록자 전용: 여러 줄을 모아 write 한 번
+static LogSite *log_throttled_sites = NULL;                             // 이 프로세스에서 제한/샘플링된 호출 지점 (생략 건수 보고용)
+static _Atomic uint8_t log_local_levels[LOG_MODULES];                   // 공유 링이 없을 때의 모듈별 레벨 (0 = DEBUG: 전부 기록)
+_Atomic uint8_t *log_module_levels = log_local_levels;                  // 호출 지점의 필터: 링 연결 후에는 공유 메모리 → 모든 프로세스에 즉시 반영
+static const char *const log_module_names[LOG_MODULES] = {"core", "accept", "worker", "shutdown", "monitor"};
+static const char *const log_level_names[LOG_OFF + 1] = {"debug", "info", "warning", "error", "off"};
+
+static const char*
 log_level_string(LogLevel level)
 {
-    switch(level) 
+    switch(level)
     {
-        case LOG_INFO: return "INFO ";
-        case LOG_ERROR: return "ERROR";
         case LOG_DEBUG: return "DEBUG";
+        case LOG_INFO: return "INFO ";
         case LOG_WARNING: return "WARNING";
+        case LOG_ERROR: return "ERROR";
         default: return "UNKN ";
     }
 }
-void 
-log_message(ServerState *state, LogLevel level, const char* format, ...)
+static int
+log_file_moved(int fd, const char *path)
+{
+    struct stat cur, named;
+    if (fstat(fd, &cur) == -1)
+        return 0;
+    return stat(path, &named) == -1 || named.st_ino != cur.st_ino || named.st_dev != cur.st_dev;   // 회전(rename)되었거나 지워짐
+}
+static void
+log_reopen_if_moved(ServerState *state, time_t now)
+{
+    static time_t checked = 0;
+    if (state == NULL || state->log_fd < 0 || now == checked || !log_file_moved(state->log_fd, LOG_FILE))
+    {
+        checked = now;                                                  // 초당 한 번만 확인
+        return;
+    }
+    checked = now;
+    int fd = open(LOG_FILE, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd == -1)
+        return;
+    dup3(fd, state->log_fd, O_CLOEXEC);                                 // 같은 fd 번호를 새 파일로: log_fd를 가진 코드는 그대로
+    close(fd);
+}
+static void
+log_write_sync(ServerState *state, LogLevel level, const char *message)
 {
-    va_list args;                                                       // 가변 인자 처리를 위한 리스트
     time_t now;                                                         // 현재 시간 획득
     char timestr[64];
-    char buffer[2048];
     char log_line[2200];
     time(&now);
     struct tm *tm_info = localtime(&now);
     strftime(timestr, sizeof(timestr), "%Y-%m-%d %H:%M:%S", tm_info);   // 날짜/시간 형식 문자열 생성
-    va_start(args, format);
-    vsnprintf(buffer, sizeof(buffer), format, args);                    // 가변 인자 포함 본문 메시지 생성
-    va_end(args);
-    int len = snprintf(log_line, sizeof(log_line), "[%s] [%s] [PID:%d] %s\n", timestr, log_level_string(level), getpid(), buffer);  // 날짜, 레벨, PID 포함 최종 로그 생성
+    int len = snprintf(log_line, sizeof(log_line), "[%s] [%s] [PID:%d] %s\n", timestr, log_level_string(level), getpid(), message);  // 날짜, 레벨, PID 포함 최종 로그 생성
     if (len < 0)
         len = 0;
     else if (len >= (int)sizeof(log_line))
         len = sizeof(log_line) - 1;
     write(STDOUT_FILENO, log_line, len);                                // 표준 출력(콘솔)에 로그 출력
+    log_reopen_if_moved(state, now);                                    // 부모 기록자가 회전한 뒤에는 새 파일로 (동기 모드 Worker)
     if (state && state->log_fd >= 0)                                    // 로그 파일이 열려 있다면
         write(state->log_fd, log_line, len);                            // 파일에도 로그 기록
 }
-void 
+static void
+log_format_time(const LogWriter *writer, uint64_t time_ns, char *out)
+{
+    uint64_t t = time_ns / 1000000000ULL + (uint64_t)writer->gmtoff;    // localtime 없이 변환: 크래시 핸들러에서도 사용
+    int64_t days = (int64_t)(t / 86400);
+    unsigned secs = (unsigned)(t % 86400);
+    int64_t z = days + 719468, era = z / 146097;                        // 일수 → 그레고리력 (civil_from_days)
+    int64_t doe = z - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+    int day = (int)(doy - (153 * mp + 2) / 5 + 1);
+    int month = (int)(mp < 10 ? mp + 3 : mp - 9);
+    int year = (int)(yoe + era * 400 + (month <= 2));
+    snprintf(out, 32, "%04d-%02d-%02d %02u:%02u:%02u", year, month, day, secs / 3600, secs / 60 % 60, secs % 60);
+}
+static void
+log_refresh_gmtoff(LogWriter *writer)
+{
+    time_t now = time(NULL);
+    if (now / 60 == writer->gmtoff_minute)                              // 분당 한 번: 서머타임 전환 반영
+        return;
+    struct tm tm_info;
+    localtime_r(&now, &tm_info);
+    writer->gmtoff = tm_info.tm_gmtoff;
+    writer->gmtoff_minute = now / 60;
+}
+static size_t
+log_format_record(const LogWriter *writer, const LogRecord *rec, char *line)
+{
+    char timestr[32];
+    log_format_time(writer, rec->time_ns, timestr);
+    int len = snprintf(line, LOG_LINE_MAX, "[%s] [%s] [PID:%d] %.*s\n", timestr, log_level_string(rec->level), rec->pid, rec->len, rec->msg);
+    if (len < 0)
+        return 0;
+    return len >= LOG_LINE_MAX ? LOG_LINE_MAX - 1 : (size_t)len;
+}
+static int
+log_site_known(LogWriter *writer, const LogRecord *rec)
+{
+    uint32_t mask = LOG_SITES_MAX - 1;
+    uint32_t slot = rec->site & mask;
+    for (uint32_t probe = 0; probe < LOG_SITES_MAX; probe++, slot = (slot + 1) & mask)
+    {
+        LogSiteDef *def = &writer->sites[slot];
+        if (def->data == NULL)
+            break;
+        if (def->id == rec->site)
+            return 1;                                                   // 이미 이 파일에 정의를 씀 (Worker마다 한 번씩 보냄)
+    }
+    if (writer->crashing || writer->site_count >= LOG_SITES_MAX / 2)    // 크래시 핸들러: malloc 없이 정의만 기록
+        return 0;
+    char *data = malloc(rec->len);
+    if (data == NULL)
+        return 0;
+    memcpy(data, rec->msg, rec->len);
+    writer->sites[slot] = (LogSiteDef){.id = rec->site, .len = rec->len, .data = data};
+    writer->site_count++;
+    return 0;
+}
+static size_t
+log_encode_record(LogWriter *writer, const LogRecord *rec, char *out)
+{
+    if (!writer->binary)
+        return log_format_record(writer, rec, out);
+    if (rec->kind == LOG_KIND_DEFINE && log_site_known(writer, rec))
+        return 0;
+    LogDiskRecord disk = {.kind = rec->kind, .level = rec->level, .len = rec->len, .site = rec->site, .pid = rec->pid, .time_ns = rec->time_ns};
+    memcpy(out, &disk, sizeof(disk));                                   // 바이너리: 포맷 없이 헤더 + 인자 바이트 그대로 (logdecode가 복원)
+    memcpy(out + sizeof(disk), rec->msg, rec->len);
+    return sizeof(disk) + rec->len;
+}
+static void
+log_batch_write(LogWriter *writer, size_t len)
+{
+    if (!writer->binary)
+        write(STDOUT_FILENO, log_batch, len);                           // 모든 프로세스의 기록을 큰 순차 쓰기 한 번으로
+    if (writer->fd >= 0)
+        write(writer->fd, log_batch, len);
+    writer->bytes += len;
+    writer->file_bytes += len;
+}
+static void
+log_writer_note(LogWriter *writer, LogLevel level, const char *format, ...)
+{
+    va_list args;
+    LogRecord note = {.time_ns = (uint64_t)time(NULL) * 1000000000ULL, .pid = getpid(), .level = (uint8_t)level};
+    va_start(args, format);
+    int len = vsnprintf(note.msg, sizeof(note.msg), format, args);      // 기록자 자신의 알림: 링을 거치지 않고 바로 기록
+    va_end(args);
+    note.len = (uint16_t)(len < 0 ? 0 : len >= (int)sizeof(note.msg) ? (int)sizeof(note.msg) - 1 : len);
+    log_batch_write(writer, log_encode_record(writer, &note, log_batch));
+}
+static uint64_t
+log_clock_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+static int
+log_ring_drain(LogWriter *writer)
+{
+    LogRing *ring = writer->ring;
+    size_t used = 0;
+    int total = 0;
+    for (;;)
+    {
+        LogRecord *rec = &ring->records[writer->tail % LOG_RING_SIZE];
+        if (atomic_load_explicit(&rec->seq, memory_order_acquire) != writer->tail + 1)
+        {
+            if (atomic_load_explicit(&ring->head, memory_order_acquire) == writer->tail)
+                break;                                                  // 비었음
+            uint64_t now = log_clock_ms();                              // 예약됐지만 아직 게시 전
+            if (writer->stall_since_ms == 0)
+                writer->stall_since_ms = now;
+            if (now - writer->stall_since_ms < LOG_STALL_MS)
+                break;                                                  // 다음 주기에 다시 확인 (프로세스별 순서 유지)
+            uint64_t owner = atomic_load_explicit(&rec->owner, memory_order_relaxed);
+            pid_t pid = (pid_t)(uint32_t)owner;
+            if (owner >> 32 != LOG_OWNER(writer->tail, 0) >> 32 || pid <= 0 || kill(pid, 0) != -1 || errno != ESRCH)
+            {
+                writer->stall_since_ms = now;                           // 살아 있는 생산자는 멈춰 있어도 memcpy 중일 수 있음: 건너뛰면 새 기록이 찢어짐
+                break;
+            }
+            uint64_t expected = writer->tail;
+            if (atomic_compare_exchange_strong(&rec->seq, &expected, writer->tail + LOG_RING_SIZE))
+            {
+                writer->skipped++;                                      // 기록 중 죽은 Worker: 슬롯을 건너뛰어 링 정체 방지
+                writer->tail++;
+            }
+            writer->stall_since_ms = 0;
+            continue;
+        }
+        writer->stall_since_ms = 0;
+        if (used + LOG_LINE_MAX > sizeof(log_batch))
+        {
+            log_batch_write(writer, used);
+            used = 0;
+        }
+        used += log_encode_record(writer, rec, log_batch + used);
+        atomic_store_explicit(&rec->seq, writer->tail + LOG_RING_SIZE, memory_order_release);   // 슬롯 반납 (다음 바퀴의 생산자용)
+        writer->tail++;
+        writer->written++;
+        total++;
+    }
+    uint64_t dropped = atomic_load_explicit(&ring->dropped, memory_order_relaxed);
+    if (dropped != writer->dropped_reported)                            // 유실은 조용히 넘기지 않고 건수를 남김
+    {
+        LogRecord note = {.time_ns = (uint64_t)time(NULL) * 1000000000ULL, .pid = getpid(), .level = LOG_WARNING};
+        note.len = (uint16_t)snprintf(note.msg, sizeof(note.msg), "log_ring_drain() : 로그 링 가득 참, %llu건 유실",
+                                      (unsigned long long)(dropped - writer->dropped_reported));
+        writer->dropped_reported = dropped;
+        if (used + LOG_LINE_MAX > sizeof(log_batch))
+        {
+            log_batch_write(writer, used);
+            used = 0;
+        }
+        used += log_encode_record(writer, &note, log_batch + used);
+    }
+    if (used > 0)
+        log_batch_write(writer, used);
+    return total;
+}
+static int
+log_binary_open(void)
+{
+    int fd = open(LOG_BINARY_FILE, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd == -1)
+    {
+        fprintf(stderr, "log_binary_open() : %s 열기 실패: %s, 텍스트로 기록\n", LOG_BINARY_FILE, strerror(errno));
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size == 0)
+        write(fd, LOG_BINARY_MAGIC, strlen(LOG_BINARY_MAGIC));         // 새 파일: 형식 표시 (logdecode가 확인)
+    return fd;
+}
+static void
+log_compress_spawn(LogWriter *writer, const char *path)
+{
+    LogCompressJob *job = NULL;
+    for (int i = 0; i < LOG_COMPRESS_JOBS && job == NULL; i++)
+        if (writer->compress[i].path[0] == '\0')
+            job = &writer->compress[i];
+    if (job == NULL)
+    {
+        log_writer_note(writer, LOG_WARNING, "log_compress_spawn() : 압축 작업 %d개 진행 중, %s는 압축하지 않음", LOG_COMPRESS_JOBS, path);
+        return;
+    }
+    snprintf(job->path, sizeof(job->path), "%s", path);
+    job->pid = 0;
+    job->due_ms = log_clock_ms() + LOG_COMPRESS_DELAY_SEC * 1000ULL;    // 동기 모드 Worker가 새 파일로 옮겨갈 시간
+}
+static void
+log_compress_start(LogWriter *writer, LogCompressJob *job)
+{
+    pid_t pid = fork();                                                 // glibc fork: atfork 처리로 malloc 락이 정상인 상태에서 복제
+    if (pid == 0)
+    {
+        sigset_t none;
+        sigemptyset(&none);
+        sigprocmask(SIG_SETMASK, &none, NULL);                          // 기록자 스레드의 차단 마스크를 gzip에 넘기지 않음
+        setsid();                                                       // 서버 프로세스 그룹과 분리: Ctrl-C/kill(0, ...)에 중단되지 않음
+        setpriority(PRIO_PROCESS, 0, 19);
+        syscall(SYS_ioprio_set, 1, 0, (3 << 13));                       // IOPRIO_WHO_PROCESS, IOPRIO_CLASS_IDLE: 서버 I/O가 없을 때만 디스크 사용
+        if (close_range(3, ~0U, 0) == -1)                               // 리스닝 소켓 등을 쥐고 있지 않도록
+            for (int fd = 3; fd < 1024; fd++)
+                close(fd);
+        execlp("gzip", "gzip", "-f", "-q", job->path, (char *)NULL);
+        _exit(127);
+    }
+    if (pid == -1)
+    {
+        log_writer_note(writer, LOG_WARNING, "log_compress_start() : fork() 실패: %s, %s는 압축하지 않음", strerror(errno), job->path);
+        job->path[0] = '\0';
+        return;
+    }
+    job->pid = pid;
+    job->pidfd = pidfd_open(pid, 0);                                    // 메인 루프의 waitpid(-1)가 먼저 회수할 수 있음: PID 재사용과 무관하게 이 프로세스만 가리킴
+    if (job->pidfd == -1)
+        job->path[0] = '\0';                                           // 이미 종료되어 회수됨
+}
+static void
+log_compress_poll(LogWriter *writer, int flush)
+{
+    uint64_t now = log_clock_ms();
+    for (int i = 0; i < LOG_COMPRESS_JOBS; i++)
+    {
+        LogCompressJob *job = &writer->compress[i];
+        if (job->path[0] == '\0')
+            continue;
+        if (job->pid == 0)
+        {
+            if (flush || now >= job->due_ms)                            // 종료 시에는 대기 중인 작업도 바로 시작 (gzip은 서버보다 오래 살아도 됨)
+                log_compress_start(writer, job);
+            continue;
+        }
+        siginfo_t info = {0};
+        if (waitid(P_PIDFD, (id_t)job->pidfd, &info, WEXITED | WNOHANG) == 0 && info.si_pid == 0)
+            continue;                                                   // 아직 압축 중
+        if (info.si_pid != 0 && (info.si_code != CLD_EXITED || info.si_status != 0))
+            log_writer_note(writer, LOG_WARNING, "log_compress_poll() : %s 압축 실패 (gzip 종료 코드 %d), 원본 유지", job->path, info.si_code == CLD_EXITED ? info.si_status : -1);
+        close(job->pidfd);                                              // ECHILD: handle_child_died()가 먼저 회수함 (Worker가 아니므로 집계에서 제외)
+        job->pid = 0;
+        job->path[0] = '\0';
+    }
+}
+static void
+log_reemit_sites(LogWriter *writer)
+{
+    size_t used = 0;
+    uint64_t now_ns = (uint64_t)time(NULL) * 1000000000ULL;
+    for (int i = 0; i < LOG_SITES_MAX; i++)
+    {
+        const LogSiteDef *def = &writer->sites[i];
+        if (def->data == NULL)
+            continue;
+        if (used + sizeof(LogDiskRecord) + def->len > sizeof(log_batch))
+        {
+            log_batch_write(writer, used);
+            used = 0;
+        }
+        LogDiskRecord disk = {.kind = LOG_KIND_DEFINE, .level = LOG_INFO, .len = def->len, .site = def->id, .pid = getpid(), .time_ns = now_ns};
+        memcpy(log_batch + used, &disk, sizeof(disk));                  // 새 파일만으로 복원 가능하도록 호출 지점 정의를 다시 씀
+        memcpy(log_batch + used + sizeof(disk), def->data, def->len);
+        used += sizeof(disk) + def->len;
+    }
+    if (used > 0)
+        log_batch_write(writer, used);
+}
+static void
+log_rotate(LogWriter *writer, int external)
+{
+    const char *path = writer->binary ? LOG_BINARY_FILE : LOG_FILE;
+    char rotated[LOG_PATH_MAX] = "";
+    if (!external)
+    {
+        char stamp[32], gz[LOG_PATH_MAX + 4];
+        time_t now = time(NULL);
+        struct tm tm_info;
+        localtime_r(&now, &tm_info);
+        strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &tm_info);
+        int n = snprintf(rotated, sizeof(rotated), "%s.%s", path, stamp);
+        struct stat st;
+        for (int seq = 1; seq < 100; seq++)                             // 같은 초에 여러 번 회전 (크기 기준)
+        {
+            snprintf(gz, sizeof(gz), "%s.gz", rotated);
+            if (stat(rotated, &st) == -1 && stat(gz, &st) == -1)
+                break;
+            snprintf(rotated + n, sizeof(rotated) - n, ".%d", seq);
+        }
+        if (rename(path, rotated) == -1)                                // 원자적: 쓰는 쪽은 이름과 무관하게 같은 파일에 계속 기록
+        {
+            log_writer_note(writer, LOG_ERROR, "log_rotate() : rename(%s) 실패: %s", path, strerror(errno));
+            writer->file_bytes = 0;                                     // 다음 주기까지 재시도하지 않음
+            writer->opened_ms = log_clock_ms();
+            return;
+        }
+    }
+    int fd = writer->binary ? log_binary_open() : open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd == -1)
+    {
+        log_writer_note(writer, LOG_ERROR, "log_rotate() : 새 %s 열기 실패: %s, 이전 파일에 계속 기록", path, strerror(errno));
+        return;
+    }
+    dup3(fd, writer->fd, O_CLOEXEC);                                    // 같은 fd 번호로 교체: state->log_fd도 그대로 새 파일을 가리킴 (잠금 없음)
+    close(fd);
+    writer->file_bytes = 0;
+    writer->opened_ms = log_clock_ms();
+    writer->rotations++;
+    if (writer->binary)
+        log_reemit_sites(writer);
+    else
+    {
+        const char *header = "=== Server Log Rotated ===\n";
+        write(writer->fd, header, strlen(header));
+    }
+    if (external)
+    {
+        log_writer_note(writer, LOG_INFO, "로그 파일이 외부에서 이동됨: 새 %s 열기", path);
+        return;
+    }
+    log_writer_note(writer, LOG_INFO, "로그 회전: %s → %s (백그라운드 gzip)", path, rotated);
+    log_compress_spawn(writer, rotated);
+}
+static void
+log_rotate_check(LogWriter *writer)
+{
+    static uint64_t checked_ms = 0;
+    uint64_t now = log_clock_ms();
+    if (writer->fd < 0)
+        return;
+    if ((writer->rotate_bytes && writer->file_bytes >= writer->rotate_bytes)
+        || (writer->rotate_ms && writer->file_bytes > 0 && now - writer->opened_ms >= writer->rotate_ms))
+        log_rotate(writer, 0);
+    else if (now - checked_ms >= 1000)                                  // 초당 한 번: logrotate 등이 파일을 옮겼는지
+    {
+        checked_ms = now;
+        if (log_file_moved(writer->fd, writer->binary ? LOG_BINARY_FILE : LOG_FILE))
+            log_rotate(writer, 1);
+    }
+    log_compress_poll(writer, 0);
+}
+static void *
+log_flusher(void *arg)
+{
+    LogWriter *writer = arg;
+    LogRing *ring = writer->ring;
+    int idle_rounds = 0;
+    while (atomic_load(&writer->running))
+    {
+        log_refresh_gmtoff(writer);
+        int drained = 0;
+        if (!atomic_exchange_explicit(&writer->consumer, 1, memory_order_acquire))
+        {
+            drained = log_ring_drain(writer);
+            log_rotate_check(writer);                                   // 기록자 스레드에서만 회전: 생산자(Worker)는 회전을 모름
+            atomic_store_explicit(&writer->consumer, 0, memory_order_release);
+        }
+        idle_rounds = drained > 0 ? 0 : idle_rounds + 1;
+        long wait_ms = LOG_FLUSH_INTERVAL_MS;                           // 기록이 이어지는 동안: 주기적으로 모아서 기록 (생산자는 깨우지 않음)
+        if (idle_rounds >= LOG_IDLE_ROUNDS)
+        {
+            atomic_store(&ring->sleeping, 1);                           // 한동안 조용하면 깊은 잠: 다음 생산자가 깨움 (유휴 서버가 깨어나지 않도록)
+            if (atomic_load(&ring->head) != writer->tail)               // 잠들기 직전에 예약된 기록
+            {
+                atomic_store(&ring->sleeping, 0);
+                continue;
+            }
+            wait_ms = LOG_IDLE_SLEEP_MS;
+        }
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += wait_ms / 1000;
+        deadline.tv_nsec += (wait_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L)
+        {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        sem_timedwait(&ring->wake, &deadline);                          // 종료/깊은 잠 해제 시 sem_post로 즉시 깨어남
+        atomic_store(&ring->sleeping, 0);
+    }
+    log_ring_drain(writer);                                             // 종료: 남은 기록 전부 기록
+    log_compress_poll(writer, 1);
+    return NULL;
+}
+static LogRing *
+log_ring_map(pid_t owner, int create)
+{
+    char name[64];
+    snprintf(name, sizeof(name), LOG_SHM_FMT, (int)owner);               // 부모 PID별: 같은 호스트의 여러 인스턴스 분리
+    int fd = shm_open(name, create ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDWR, 0600);
+    if (fd == -1)
+        return NULL;
+    if (create && ftruncate(fd, sizeof(LogRing)) == -1)
+    {
+        close(fd);
+        shm_unlink(name);
+        return NULL;
+    }
+    LogRing *ring = mmap(NULL, sizeof(LogRing), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    return ring == MAP_FAILED ? NULL : ring;
+}
+static void
+log_levels_attach(LogRing *ring)
+{
+    for (int m = 0; m < LOG_MODULES; m++)                               // 현재 값을 유지한 채 가리키는 곳만 교체
+        atomic_store(&(ring ? ring->levels : log_local_levels)[m], atomic_load(&log_module_levels[m]));
+    log_module_levels = ring ? ring->levels : log_local_levels;
+}
+static void
+log_writer_stop(void)
+{
+    LogWriter *writer = &log_writer;
+    if (writer->ring == NULL || !atomic_load(&writer->running))
+        return;
+    atomic_store(&writer->running, 0);
+    sem_post(&writer->ring->wake);
+    pthread_join(writer->thread, NULL);                                 // 기록자가 링을 비운 뒤 종료
+    LogRing *ring = writer->ring;
+    log_levels_attach(NULL);                                            // 해제될 공유 메모리를 더 이상 참조하지 않음
+    log_ring = NULL;                                                    // 이후 log_message는 동기 기록
+    writer->ring = NULL;
+    uint64_t dropped = atomic_load(&ring->dropped);
+    log_writer_note(writer, dropped || writer->skipped ? LOG_WARNING : LOG_INFO,
+                    "로그 링: 기록 %llu건 (%llu바이트), 유실 %llu건 (가득 참), 건너뜀 %llu건 (게시 전 죽은 생산자), 회전 %llu회",
+                    (unsigned long long)writer->written, (unsigned long long)writer->bytes, (unsigned long long)dropped,
+                    (unsigned long long)writer->skipped, (unsigned long long)writer->rotations);
+    sem_destroy(&ring->wake);
+    if (writer->binary)
+    {
+        close(writer->fd);
+        writer->fd = -1;
+        writer->binary = 0;
+    }
+    for (int i = 0; i < LOG_SITES_MAX; i++)
+    {
+        free(writer->sites[i].data);
+        writer->sites[i].data = NULL;
+    }
+    writer->site_count = 0;
+    if (writer->shared)
+    {
+        char name[64];
+        snprintf(name, sizeof(name), LOG_SHM_FMT, (int)getpid());
+        munmap(ring, sizeof(LogRing));
+        shm_unlink(name);
+    }
+    else
+        free(ring);
+}
+static void
+log_writer_start(ServerState *state)
+{
+    LogWriter *writer = &log_writer;
+    LogRing *ring = log_ring_map(getpid(), 1);                          // Worker들이 getppid()로 연결
+    writer->shared = ring != NULL;
+    if (ring == NULL)
+    {
+        fprintf(stderr, "log_writer_start() : 공유 로그 링 생성 실패, Worker는 개별 기록\n");
+        ring = calloc(1, sizeof(LogRing));
+        if (ring == NULL)
+            return;
+    }
+    for (uint64_t i = 0; i < LOG_RING_SIZE; i++)
+        atomic_init(&ring->records[i].seq, i);                          // seq == 위치: 빈 슬롯
+    sem_init(&ring->wake, 1, 0);                                        // 프로세스 간 공유: Worker가 깊은 잠의 기록자를 깨움
+    writer->ring = ring;
+    writer->tail = 0;
+    writer->fd = state->log_fd;
+    if (getenv(LOG_BINARY_ENV) != NULL && (writer->fd = log_binary_open()) != -1)
+    {
+        writer->binary = 1;                                             // ECHO_LOG_BINARY: 호출 지점 id + 인자만 기록, 포맷은 오프라인
+        log_write_sync(state, LOG_INFO, "바이너리 로그 기록: " LOG_BINARY_FILE " (logdecode로 복원)");
+    }
+    else
+        writer->fd = state->log_fd;
+    ring->binary = writer->binary;
+    const char *mb = getenv(LOG_ROTATE_MB_ENV), *secs = getenv(LOG_ROTATE_SECS_ENV);   // 0이면 해당 기준으로는 회전하지 않음
+    writer->rotate_bytes = (uint64_t)(mb ? atol(mb) : LOG_ROTATE_MB) * 1024 * 1024;
+    writer->rotate_ms = (uint64_t)(secs ? atol(secs) : LOG_ROTATE_SECS) * 1000;
+    struct stat st;
+    writer->file_bytes = writer->fd >= 0 && fstat(writer->fd, &st) == 0 ? (uint64_t)st.st_size : 0;   // 이어 쓰는 기존 파일 크기 포함
+    writer->opened_ms = log_clock_ms();
+    writer->gmtoff_minute = -1;
+    log_refresh_gmtoff(writer);
+    atomic_store(&writer->running, 1);
+    sigset_t all, saved;
+    sigfillset(&all);
+    pthread_sigmask(SIG_BLOCK, &all, &saved);                           // 기록자는 시그널을 받지 않음 (signalfd는 모든 스레드가 차단해야 동작)
+    int err = pthread_create(&writer->thread, NULL, log_flusher, writer);
+    pthread_sigmask(SIG_SETMASK, &saved, NULL);
+    if (err != 0)
+    {
+        fprintf(stderr, "log_writer_start() : pthread_create() 실패: %s\n", strerror(err));
+        atomic_store(&writer->running, 0);
+        sem_destroy(&ring->wake);
+        if (writer->binary)
+        {
+            close(writer->fd);
+            writer->fd = -1;
+            writer->binary = 0;
+        }
+        if (writer->shared)
+        {
+            char name[64];
+            snprintf(name, sizeof(name), LOG_SHM_FMT, (int)getpid());
+            munmap(ring, sizeof(LogRing));
+            shm_unlink(name);
+        }
+        else
+            free(ring);
+        writer->ring = NULL;
+        return;
+    }
+    log_levels_attach(ring);
+    log_ring = ring;
+    static int registered = 0;
+    if (!registered && atexit(log_writer_stop) == 0)                    // log_close 없이 exit()해도 남은 기록 flush
+        registered = 1;
+}
+const char *
+log_parse_spec(const char *p, LogArgSpec *spec)
+{
+    *spec = (LogArgSpec){.type = LOG_ARG_NONE, .prec = -1};
+    p++;                                                                // '%' 다음부터: 플래그, 폭, 정밀도, 길이, 변환 문자
+    if (*p == '%')
+        return p + 1;
+    while (*p && strchr("-+ #0'", *p))
+        p++;
+    if (*p == '*')
+    {
+        spec->star_width = 1;
+        p++;
+    }
+    while (*p >= '0' && *p <= '9')
+        p++;
+    if (*p == '.')
+    {
+        p++;
+        if (*p == '*')
+        {
+            spec->star_prec = 1;
+            p++;
+        }
+        else
+        {
+            spec->prec = 0;
+            for (; *p >= '0' && *p <= '9'; p++)
+                spec->prec = (int16_t)(spec->prec * 10 + (*p - '0'));
+        }
+    }
+    int wide = 0;
+    for (; *p && strchr("hlqjzt", *p); p++)
+        if (*p != 'h')
+            wide = 1;                                                   // LP64: l, ll, z, j, t 모두 8바이트
+    switch (*p)
+    {
+        case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c':
+            spec->type = wide ? LOG_ARG_LONG : LOG_ARG_INT;
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+            spec->type = LOG_ARG_DOUBLE;
+            break;
+        case 's':
+            spec->type = LOG_ARG_STRING;
+            break;
+        case 'p':
+            spec->type = LOG_ARG_POINTER;
+            break;
+        default:
+            return NULL;                                                // %n, %Lf 등: 바이너리로 옮길 수 없음 → 텍스트 기록
+    }
+    return p + 1;
+}
+static void
+log_site_init(LogSite *site, const char *format)
+{
+    uint32_t hash = 2166136261u;                                        // FNV-1a(파일, 줄, 포맷): 빌드가 같으면 프로세스가 달라도 같은 id
+    for (const char *c = site->file; *c; c++)
+        hash = (hash ^ (uint8_t)*c) * 16777619u;
+    for (int b = 0; b < 4; b++)
+        hash = (hash ^ (uint8_t)(site->line >> (b * 8))) * 16777619u;
+    for (const char *c = format; *c; c++)
+        hash = (hash ^ (uint8_t)*c) * 16777619u;
+    site->id = hash;
+    site->argc = 0;
+    for (const char *p = strchr(format, '%'); p != NULL; p = strchr(p, '%'))
+    {
+        LogArgSpec spec;
+        p = log_parse_spec(p, &spec);
+        if (p == NULL || (spec.type != LOG_ARG_NONE && site->argc == LOG_SITE_ARGS))
+        {
+            site->argc = -1;
+            break;
+        }
+        if (spec.type != LOG_ARG_NONE)
+            site->args[site->argc++] = spec;
+    }
+    atomic_store_explicit(&site->ready, 1, memory_order_release);
+}
+static size_t
+log_encode_args(const LogSite *site, char *out, va_list args)
+{
+    size_t used = 0;
+    for (int i = 0; i < site->argc; i++)
+    {
+        const LogArgSpec *spec = &site->args[i];
+        int prec = spec->prec;
+        if (spec->star_width)
+        {
+            int width = va_arg(args, int);
+            memcpy(out + used, &width, sizeof(width));
+            used += sizeof(width);
+        }
+        if (spec->star_prec)
+        {
+            prec = va_arg(args, int);
+            memcpy(out + used, &prec, sizeof(prec));
+            used += sizeof(prec);
+        }
+        switch (spec->type)
+        {
+            case LOG_ARG_INT:
+            {
+                int v = va_arg(args, int);
+                memcpy(out + used, &v, sizeof(v));
+                used += sizeof(v);
+                break;
+            }
+            case LOG_ARG_LONG:
+            {
+                long long v = va_arg(args, long long);
+                memcpy(out + used, &v, sizeof(v));
+                used += sizeof(v);
+                break;
+            }
+            case LOG_ARG_DOUBLE:
+            {
+                double v = va_arg(args, double);
+                memcpy(out + used, &v, sizeof(v));
+                used += sizeof(v);
+                break;
+            }
+            case LOG_ARG_POINTER:
+            {
+                uint64_t v = (uint64_t)(uintptr_t)va_arg(args, void *);
+                memcpy(out + used, &v, sizeof(v));
+                used += sizeof(v);
+                break;
+            }
+            case LOG_ARG_STRING:
+            {
+                const char *str = va_arg(args, const char *);
+                if (str == NULL)
+                    str = "(null)";
+                size_t reserve = (size_t)(site->argc - i - 1) * 16;    // 뒤 인자 자리 (문자열 외에는 인자당 최대 16바이트)
+                size_t cap = LOG_RECORD_MAX - used - sizeof(uint16_t) - reserve;
+                size_t n = prec >= 0 ? strnlen(str, (size_t)prec) : strlen(str);
+                if (n > cap)
+                {
+                    n = cap;
+                    while (n > 0 && ((unsigned char)str[n] & 0xC0) == 0x80)   // 잘린 UTF-8 문자는 통째로 제외
+                        n--;
+                }
+                uint16_t len = (uint16_t)n;
+                memcpy(out + used, &len, sizeof(len));
+                memcpy(out + used + sizeof(len), str, n);
+                used += sizeof(len) + n;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return used;
+}
+static int
+log_ring_push(LogRing *ring, LogKind kind, LogLevel level, uint32_t site, const char *data, size_t len)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME_COARSE, &ts);                          // vDSO: 시간 포맷은 기록자가 담당
+    LogRecord *rec;
+    pid_t self = getpid();
+    uint64_t pos = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    int blocking = kind == LOG_KIND_DEFINE || level == LOG_ERROR || level == LOG_WARNING;
+    for (int spins = 0;;)                                               // 유계 MPSC 링: 슬롯별 seq로 락 없이 예약 (프로세스 간 공유)
+    {
+        rec = &ring->records[pos % LOG_RING_SIZE];
+        int64_t diff = (int64_t)(atomic_load_explicit(&rec->seq, memory_order_acquire) - pos);
+        if (diff == 0)
+        {
+            uint64_t owner = atomic_load_explicit(&rec->owner, memory_order_relaxed);
+            if (owner >> 32 != LOG_OWNER(pos, 0) >> 32)                 // 예약 전에 소유자를 남김: 예약 직후 죽어도 기록자가 판별 가능
+                atomic_compare_exchange_strong_explicit(&rec->owner, &owner, LOG_OWNER(pos, self), memory_order_relaxed, memory_order_relaxed);
+            if (atomic_compare_exchange_weak_explicit(&ring->head, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)                                              // 가득 참
+        {
+            if (!blocking || ++spins > LOG_BLOCK_SPINS)
+            {
+                atomic_fetch_add_explicit(&ring->dropped, 1, memory_order_relaxed);   // INFO/DEBUG는 즉시, ERROR/WARNING은 잠깐 기다린 뒤 버림
+                return -1;
+            }
+            if (spins == 1)
+                sem_post(&ring->wake);                                  // 가득 찬 링은 주기를 기다리지 않고 바로 비움
+            sched_yield();
+            pos = atomic_load_explicit(&ring->head, memory_order_relaxed);
+        }
+        else
+            pos = atomic_load_explicit(&ring->head, memory_order_relaxed);   // 다른 생산자가 먼저 가져감
+    }
+    atomic_store_explicit(&rec->owner, LOG_OWNER(pos, self), memory_order_relaxed);   // 예약 경쟁에서 진 생산자가 남긴 값을 덮어씀
+    rec->time_ns = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+    rec->pid = self;
+    rec->site = site;
+    rec->kind = (uint8_t)kind;
+    rec->level = (uint8_t)level;
+    rec->len = (uint16_t)len;
+    memcpy(rec->msg, data, len);
+    uint64_t expected = pos;
+    if (!atomic_compare_exchange_strong_explicit(&rec->seq, &expected, pos + 1, memory_order_release, memory_order_relaxed))
+    {
+        atomic_fetch_add_explicit(&ring->dropped, 1, memory_order_relaxed);   // 너무 오래 멈춰 기록자가 이미 건너뛴 슬롯
+        return -1;
+    }
+    atomic_thread_fence(memory_order_seq_cst);                          // sleeping 확인과 게시의 순서 보장 (깨우기 누락 방지)
+    if (atomic_load_explicit(&ring->sleeping, memory_order_relaxed) && atomic_exchange(&ring->sleeping, 0))
+        sem_post(&ring->wake);                                          // 기록자가 깊은 잠에 든 경우에만 시스템 콜
+    return 0;
+}
+static void
+log_site_report(ServerState *state, LogSite *site, uint64_t now)
+{
+    uint64_t suppressed = site->suppressed;
+    site->suppressed = 0;
+    site->report_ms = now;
+    if (site->level < LOG_MIN_LEVEL || site->level < atomic_load_explicit(&log_module_levels[site->module], memory_order_relaxed))
+        return;                                                         // 호출 지점 모듈의 레벨로 판정 (log.c의 core 레벨이 아님)
+    char body[LOG_RECORD_MAX];
+    int len;
+    if (site->sample > 1)
+        len = snprintf(body, sizeof(body), "%s:%d: 유사 메시지 %llu건 생략 (1/%u 샘플링, 누적 %llu건)", site->file, site->line,
+                       (unsigned long long)suppressed, site->sample, (unsigned long long)site->suppressed_total);
+    else
+        len = snprintf(body, sizeof(body), "%s:%d: 유사 메시지 %llu건 생략 (초당 %u건 제한, 누적 %llu건)", site->file, site->line,
+                       (unsigned long long)suppressed, site->limit, (unsigned long long)site->suppressed_total);
+    if (len < 0)
+        return;
+    if (len >= (int)sizeof(body))
+        len = sizeof(body) - 1;
+    if (log_ring == NULL)
+        log_write_sync(state, (LogLevel)site->level, body);
+    else
+        log_ring_push(log_ring, LOG_KIND_TEXT, (LogLevel)site->level, 0, body, len);   // 텍스트 레코드: 바이너리 모드에서도 log.c 호출 지점으로 묶이지 않음
+}
+static int
+log_site_throttled(ServerState *state, LogSite *site, LogLevel level)
+{
+    uint64_t now = log_clock_ms();
+    if (site->report_ms == 0)
+    {
+        site->report_ms = now;                                          // 첫 호출: 보고 목록에 등록
+        site->next = log_throttled_sites;
+        log_throttled_sites = site;
+    }
+    site->level = level;
+    int drop = 0;
+    if (site->sample > 1 && site->calls++ % site->sample != 0)          // 1/N 샘플링: 첫 번째는 항상 기록
+        drop = 1;
+    else if (site->limit > 0)
+    {
+        if (now - site->window_ms >= 1000)                              // 1초 고정 창
+        {
+            site->window_ms = now;
+            site->window_count = 0;
+        }
+        drop = site->window_count++ >= site->limit;
+    }
+    if (drop)
+    {
+        site->suppressed++;
+        site->suppressed_total++;
+        return 1;
+    }
+    if (site->suppressed > 0 && now - site->report_ms >= LOG_SUPPRESS_REPORT_MS)
+        log_site_report(state, site, now);                              // 호출 지점당 주기마다 한 줄: 폭주해도 기록량은 유계
+    return 0;
+}
+void
+log_report_suppressed(ServerState *state, int force)
+{
+    uint64_t now = log_clock_ms();
+    for (LogSite *site = log_throttled_sites; site != NULL; site = site->next)
+        if (site->suppressed > 0 && (force || now - site->report_ms >= LOG_SUPPRESS_REPORT_MS))
+            log_site_report(state, site, now);                          // 조용해진 호출 지점의 남은 생략 건수
+}
+void
+log_emit(LogSite *site, ServerState *state, LogLevel level, const char* format, ...)
+{
+    va_list args;                                                       // 가변 인자 처리를 위한 리스트
+    if ((site->limit > 0 || site->sample > 1) && log_site_throttled(state, site, level))
+        return;                                                         // 포맷/링 예약 전에 버림: 생략 건수만 증가
+    LogRing *ring = log_ring;
+    if (ring == NULL)
+    {
+        char buffer[2048];
+        va_start(args, format);
+        vsnprintf(buffer, sizeof(buffer), format, args);                // 가변 인자 포함 본문 메시지 생성
+        va_end(args);
+        log_write_sync(state, level, buffer);                           // 공유 링 연결 전/종료 후
+        return;
+    }
+    char body[LOG_RECORD_MAX];
+    if (ring->binary)
+    {
+        if (!atomic_load_explicit(&site->ready, memory_order_acquire))
+            log_site_init(site, format);                                // 호출 지점당 한 번: 포맷 해석 + id
+        if (site->argc >= 0)
+        {
+            if (!site->defined)
+            {
+                int n = snprintf(body, sizeof(body), "%s:%d", site->file, site->line);
+                size_t flen = strnlen(format, sizeof(body) - n - 1);
+                memcpy(body + n + 1, format, flen);                     // "파일:줄\0포맷": 프로세스별 첫 기록 전에 한 번
+                if (log_ring_push(ring, LOG_KIND_DEFINE, level, site->id, body, n + 1 + flen) == -1)
+                    return;                                             // 정의 없이는 복원 불가: 다음 호출에서 다시 시도
+                site->defined = 1;
+            }
+            va_start(args, format);
+            size_t len = log_encode_args(site, body, args);             // vsnprintf 없이 인자 바이트만 복사
+            va_end(args);
+            log_ring_push(ring, LOG_KIND_BINARY, level, site->id, body, len);
+            return;
+        }
+    }
+    va_start(args, format);
+    int len = vsnprintf(body, sizeof(body), format, args);              // 슬롯 예약 전에 포맷: 예약~게시 구간을 memcpy 한 번으로 최소화
+    va_end(args);
+    if (len < 0)
+        len = 0;
+    else if (len >= (int)sizeof(body))
+    {
+        len = sizeof(body) - 1;
+        while (len > 0 && ((unsigned char)body[len] & 0xC0) == 0x80)    // 잘린 UTF-8 문자는 통째로 제외
+            len--;
+    }
+    log_ring_push(ring, LOG_KIND_TEXT, level, 0, body, len);
+}
+static int
+log_level_parse(const char *name, size_t len)
+{
+    for (int l = 0; l <= LOG_OFF; l++)
+        if (strlen(log_level_names[l]) == len && strncasecmp(name, log_level_names[l], len) == 0)
+            return l;
+    if (len == 4 && strncasecmp(name, "warn", 4) == 0)
+        return LOG_WARNING;
+    return -1;
+}
+int
+log_levels_apply(const char *spec)
+{
+    int applied = 0;
+    const char *p = spec;
+    while (*p)
+    {
+        if (*p == '#')                                                  // 설정 파일 주석: 줄 끝까지
+        {
+            p += strcspn(p, "\n");
+            continue;
+        }
+        size_t len = strcspn(p, " ,;\t\r\n");
+        if (len == 0)
+        {
+            p++;
+            continue;
+        }
+        const char *eq = memchr(p, '=', len);                           // "모듈=레벨" 또는 "레벨"(전체)
+        size_t name_len = eq ? (size_t)(eq - p) : 0;
+        int all = eq == NULL || (name_len == 3 && strncasecmp(p, "all", 3) == 0);
+        int level = eq ? log_level_parse(eq + 1, len - name_len - 1) : log_level_parse(p, len);
+        if (level < 0)
+            return -1;
+        int matched = 0;
+        for (int m = 0; m < LOG_MODULES; m++)
+        {
+            if (!all && (strlen(log_module_names[m]) != name_len || strncasecmp(p, log_module_names[m], name_len) != 0))
+                continue;
+            atomic_store_explicit(&log_module_levels[m], (uint8_t)level, memory_order_relaxed);
+            matched++;
+        }
+        if (matched == 0)
+            return -1;                                                  // 모르는 모듈
+        applied += matched;
+        p += len;
+    }
+    return applied;
+}
+size_t
+log_levels_format(char *out, size_t cap)
+{
+    size_t used = 0;
+    for (int m = 0; m < LOG_MODULES && used < cap; m++)
+    {
+        int n = snprintf(out + used, cap - used, "%s%s=%s", m ? " " : "", log_module_names[m],
+                         log_level_names[atomic_load_explicit(&log_module_levels[m], memory_order_relaxed) % (LOG_OFF + 1)]);
+        if (n < 0)
+            break;
+        used += (size_t)n;
+    }
+    return used < cap ? used : cap - 1;
+}
+int
+log_levels_reload(ServerState *state)
+{
+    char spec[1024], current[128];
+    int fd = open(LOG_LEVELS_FILE, O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+    {
+        log_message(state, LOG_WARNING, "log_levels_reload() : %s 열기 실패: %s", LOG_LEVELS_FILE, strerror(errno));
+        return -1;
+    }
+    ssize_t n = read(fd, spec, sizeof(spec) - 1);
+    close(fd);
+    spec[n > 0 ? n : 0] = '\0';
+    if (log_levels_apply(spec) < 0)
+    {
+        log_message(state, LOG_ERROR, "log_levels_reload() : %s 형식 오류 (예: worker=debug accept=info)", LOG_LEVELS_FILE);
+        return -1;
+    }
+    log_levels_format(current, sizeof(current));
+    log_message(state, LOG_WARNING, "로그 레벨 변경 (%s): %s", LOG_LEVELS_FILE, current);
+    return 0;
+}
+void
+log_flush_crash(void)
+{
+    LogWriter *writer = &log_writer;
+    if (writer->ring == NULL)                                           // Worker: 기록은 이미 공유 링에 있음 (부모가 기록)
+        return;
+    for (int i = 0; i < LOG_BLOCK_SPINS && atomic_exchange(&writer->consumer, 1); i++)
+        sched_yield();                                                  // 기록자 배치가 끝나길 잠깐 대기 (기록자 자신이 죽었으면 그대로 진행)
+    writer->crashing = 1;
+    log_ring_drain(writer);                                             // 크래시 직전 기록까지 남김 (localtime/malloc 없음)
+}
+void
 log_init(ServerState *state)
 {
     if (state == NULL)
         return;
+    if (getpid() != state->parent_pid && getenv(LOG_SYNC_ENV) == NULL && (log_ring = log_ring_map(getppid(), 0)) != NULL)
+    {
+        log_module_levels = log_ring->levels;                                   // 부모가 바꾼 모듈별 레벨을 바로 따름
+        return;                                                                 // Worker: 부모의 공유 링에 기록 (server.log를 직접 열지 않음)
+    }
+    const char *levels = getenv(LOG_LEVELS_ENV);                                // 예: ECHO_LOG_LEVELS="info,worker=debug"
+    if (levels != NULL && log_levels_apply(levels) < 0)
+        fprintf(stderr, "log_init() : %s 형식 오류: %s\n", LOG_LEVELS_ENV, levels);
     state->log_fd = open(LOG_FILE, O_WRONLY | O_CREAT | O_APPEND, 0644);        // 로그 파일 생성 또는 추가 모드로 열기
-    if (state->log_fd == -1) 
+    if (state->log_fd == -1)
     {
         fprintf(stderr, "log_init() : 로그 파일 열기 실패: %s\n", strerror(errno));
         return;
     }
     int flags = fcntl(state->log_fd, F_GETFD);                                  // 파일 디스크립터 플래그 읽기
-    if (flags != -1) 
+    if (flags != -1)
     {
         if (fcntl(state->log_fd, F_SETFD, flags | FD_CLOEXEC) == -1)            // exec 시 이 파일이 닫히도록 설정
             fprintf(stderr, "log_init() : FD_CLOEXEC 설정 실패: %s\n", strerror(errno));
     }
     const char *header = "=== Server Log Started ===\n";
     write(state->log_fd, header, strlen(header));
+    if (getpid() == state->parent_pid && getenv(LOG_SYNC_ENV) == NULL)          // ECHO_LOG_SYNC: 디버깅용 동기 기록
+        log_writer_start(state);                                                // 부모: 공유 링 생성 + 단일 기록자 스레드
     log_message(state, LOG_INFO, "로그 시스템 초기화 완료");
 }
 void log_close(ServerState *state)
 {
-    if (state == NULL || state->log_fd < 0)
+    if (state == NULL)
+        return;
+    log_report_suppressed(state, 1);                                            // 종료 전 남은 생략 건수
+    if (log_ring != NULL && log_writer.ring == NULL)                            // Worker: 매핑만 해제 (남은 기록은 부모가 기록)
+    {
+        log_levels_attach(NULL);
+        munmap(log_ring, sizeof(LogRing));
+        log_ring = NULL;
+    }
+    if (state->log_fd < 0)
         return;
+    log_writer_stop();                                                          // 링에 남은 기록을 모두 쓴 뒤 파일을 닫음
     const char *footer = "=== Server Log Closed ===\n";
     write(state->log_fd, footer, strlen(footer));
     if (close(state->log_fd) == -1)
@@ -0,0 +1,242 @@
+#define _DEFAULT_SOURCE
+#include "server_function.h"
+
+typedef struct
+{
+    uint32_t id;
+    char *location;                                                             // "파일:줄"
+    const char *format;                                                         // location 뒤에 이어서 저장
+    unsigned long count;
+} LogDecodeSite;
+
+static LogDecodeSite sites[LOG_SITES_MAX];
+
+static LogDecodeSite *
+logdecode_site(uint32_t id, int insert)
+{
+    uint32_t mask = LOG_SITES_MAX - 1;
+    uint32_t slot = id & mask;
+    for (uint32_t probe = 0; probe < LOG_SITES_MAX; probe++, slot = (slot + 1) & mask)
+    {
+        if (sites[slot].location == NULL)
+            return insert ? &sites[slot] : NULL;
+        if (sites[slot].id == id)
+            return &sites[slot];
+    }
+    return NULL;
+}
+static int
+logdecode_take(const char *payload, size_t len, size_t *off, void *out, size_t size)
+{
+    if (*off + size > len)
+        return -1;
+    memcpy(out, payload + *off, size);
+    *off += size;
+    return 0;
+}
+static void
+logdecode_render(const LogDecodeSite *site, const char *payload, size_t len, char *out, size_t out_size)
+{
+    size_t used = 0, off = 0;
+    const char *p = site->format;
+    while (*p && used + 1 < out_size)
+    {
+        if (*p != '%')
+        {
+            out[used++] = *p++;
+            continue;
+        }
+        LogArgSpec spec;
+        const char *end = log_parse_spec(p, &spec);                             // 서버와 같은 해석기: 인자 순서/크기가 일치
+        if (end == NULL)
+            break;
+        if (spec.type == LOG_ARG_NONE)
+        {
+            out[used++] = '%';
+            p = end;
+            continue;
+        }
+        char sub[32];
+        snprintf(sub, sizeof(sub), "%.*s", (int)(end - p), p);                 // 변환 하나만 잘라 snprintf로 그대로 재현 (폭/정밀도/플래그 포함)
+        int star[2], nstar = 0, ok = 0;
+        if (spec.star_width)
+            ok |= logdecode_take(payload, len, &off, &star[nstar++], sizeof(int));
+        if (spec.star_prec)
+            ok |= logdecode_take(payload, len, &off, &star[nstar++], sizeof(int));
+        union
+        {
+            int i;
+            long long ll;
+            double d;
+            uint64_t u64;
+        } v;
+        char str[LOG_RECORD_MAX + 1];
+        switch (spec.type)
+        {
+            case LOG_ARG_INT:
+                ok |= logdecode_take(payload, len, &off, &v.i, sizeof(v.i));
+                break;
+            case LOG_ARG_LONG:
+                ok |= logdecode_take(payload, len, &off, &v.ll, sizeof(v.ll));
+                break;
+            case LOG_ARG_DOUBLE:
+                ok |= logdecode_take(payload, len, &off, &v.d, sizeof(v.d));
+                break;
+            case LOG_ARG_POINTER:
+                ok |= logdecode_take(payload, len, &off, &v.u64, sizeof(v.u64));
+                break;
+            default:
+            {
+                uint16_t slen = 0;
+                ok |= logdecode_take(payload, len, &off, &slen, sizeof(slen));
+                if (ok == 0)
+                    ok |= logdecode_take(payload, len, &off, str, slen);
+                str[ok == 0 ? slen : 0] = '\0';
+                break;
+            }
+        }
+        if (ok != 0)
+        {
+            used += snprintf(out + used, out_size - used, "<?>");              // 잘린 기록
+            break;
+        }
+        int a = nstar > 0 ? star[0] : 0, b = nstar > 1 ? star[1] : 0;
+        size_t room = out_size - used;
+        int n;
+        switch (spec.type)
+        {
+            case LOG_ARG_INT:
+                n = nstar == 2 ? snprintf(out + used, room, sub, a, b, v.i) : nstar == 1 ? snprintf(out + used, room, sub, a, v.i) : snprintf(out + used, room, sub, v.i);
+                break;
+            case LOG_ARG_LONG:
+                n = nstar == 2 ? snprintf(out + used, room, sub, a, b, v.ll) : nstar == 1 ? snprintf(out + used, room, sub, a, v.ll) : snprintf(out + used, room, sub, v.ll);
+                break;
+            case LOG_ARG_DOUBLE:
+                n = nstar == 2 ? snprintf(out + used, room, sub, a, b, v.d) : nstar == 1 ? snprintf(out + used, room, sub, a, v.d) : snprintf(out + used, room, sub, v.d);
+                break;
+            case LOG_ARG_POINTER:
+            {
+                void *ptr = (void *)(uintptr_t)v.u64;
+                n = nstar == 2 ? snprintf(out + used, room, sub, a, b, ptr) : nstar == 1 ? snprintf(out + used, room, sub, a, ptr) : snprintf(out + used, room, sub, ptr);
+                break;
+            }
+            default:
+                n = nstar == 2 ? snprintf(out + used, room, sub, a, b, str) : nstar == 1 ? snprintf(out + used, room, sub, a, str) : snprintf(out + used, room, sub, str);
+                break;
+        }
+        if (n < 0)
+            break;
+        used = (size_t)n >= room ? out_size - 1 : used + n;
+        p = end;
+    }
+    out[used] = '\0';
+}
+static int
+logdecode_file(const char *path, FILE *in)
+{
+    static const char *const levels[] = {"DEBUG", "INFO ", "WARNING", "ERROR"};
+    char magic[sizeof(LOG_BINARY_MAGIC) - 1];
+    if (fread(magic, 1, sizeof(magic), in) != sizeof(magic) || memcmp(magic, LOG_BINARY_MAGIC, sizeof(magic)) != 0)
+    {
+        fprintf(stderr, "logdecode_file() : %s: 바이너리 로그가 아님\n", path);
+        return -1;
+    }
+    LogDiskRecord disk;
+    char payload[LOG_RECORD_MAX + 1], body[2048];
+    unsigned long undefined = 0;
+    while (fread(&disk, sizeof(disk), 1, in) == 1)
+    {
+        if (disk.len > LOG_RECORD_MAX || fread(payload, 1, disk.len, in) != disk.len)
+        {
+            fprintf(stderr, "logdecode_file() : %s: 손상되었거나 잘린 기록\n", path);
+            return -1;
+        }
+        payload[disk.len] = '\0';
+        if (disk.kind == LOG_KIND_DEFINE)
+        {
+            LogDecodeSite *site = logdecode_site(disk.site, 1);
+            if (site == NULL || site->location != NULL)
+                continue;                                                       // 같은 id는 같은 포맷 (재시작/회전 후 중복 정의)
+            char *copy = malloc(disk.len + 1);
+            if (copy == NULL)
+                return -1;
+            memcpy(copy, payload, disk.len + 1);
+            site->id = disk.site;
+            site->location = copy;
+            site->format = copy + strnlen(copy, disk.len) + (strnlen(copy, disk.len) < disk.len);
+            continue;
+        }
+        if (disk.kind == LOG_KIND_BINARY)
+        {
+            LogDecodeSite *site = logdecode_site(disk.site, 0);
+            if (site == NULL)
+            {
+                snprintf(body, sizeof(body), "<정의 없는 호출 지점 %08x, %u바이트>", disk.site, disk.len);
+                undefined++;
+            }
+            else
+            {
+                logdecode_render(site, payload, disk.len, body, sizeof(body));
+                site->count++;
+            }
+        }
+        else
+            snprintf(body, sizeof(body), "%s", payload);                        // 텍스트 기록 (포맷 불가 호출 지점, 기록자 알림)
+        time_t secs = (time_t)(disk.time_ns / 1000000000ULL);
+        struct tm tm_info;
+        char timestr[32];
+        localtime_r(&secs, &tm_info);
+        strftime(timestr, sizeof(timestr), "%Y-%m-%d %H:%M:%S", &tm_info);
+        printf("[%s] [%s] [PID:%d] %s\n", timestr, disk.level < 4 ? levels[disk.level] : "UNKN ", disk.pid, body);
+    }
+    if (undefined)
+        fprintf(stderr, "logdecode_file() : %s: 정의를 찾지 못한 기록 %lu건\n", path, undefined);
+    return 0;
+}
+static int
+logdecode_by_count(const void *a, const void *b)
+{
+    unsigned long ca = ((const LogDecodeSite *)a)->count;
+    unsigned long cb = ((const LogDecodeSite *)b)->count;
+    return ca > cb ? -1 : ca < cb;                                              // 가장 많이 기록한 호출 지점 먼저
+}
+int
+main(int argc, char *argv[])
+{
+    int summary = 0, failed = 0, opt;
+    while ((opt = getopt(argc, argv, "s")) != -1)
+    {
+        if (opt == 's')
+            summary = 1;
+        else
+        {
+            fprintf(stderr, "사용법: %s [-s] [바이너리 로그 ...] (기본 %s, -: 표준 입력)\n", argv[0], LOG_BINARY_FILE);
+            return EXIT_FAILURE;
+        }
+    }
+    const char *fallback[] = {LOG_BINARY_FILE};
+    char **paths = optind < argc ? &argv[optind] : (char **)fallback;
+    int count = optind < argc ? argc - optind : 1;
+    for (int i = 0; i < count; i++)
+    {
+        FILE *in = strcmp(paths[i], "-") == 0 ? stdin : fopen(paths[i], "rb");
+        if (in == NULL)
+        {
+            fprintf(stderr, "main() : %s 열기 실패: %s\n", paths[i], strerror(errno));
+            failed = 1;
+            continue;
+        }
+        if (logdecode_file(paths[i], in) == -1)
+            failed = 1;
+        if (in != stdin)
+            fclose(in);
+    }
+    if (summary)
+    {
+        qsort(sites, LOG_SITES_MAX, sizeof(LogDecodeSite), logdecode_by_count);
+        fprintf(stderr, "%10s  %-28s %s\n", "COUNT", "SITE", "FORMAT");
+        for (int i = 0; i < LOG_SITES_MAX && sites[i].count > 0; i++)
+            fprintf(stderr, "%10lu  %-28s %s\n", sites[i].count, sites[i].location, sites[i].format);
+    }
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,171 @@
+#include "lz4_block.h"
+
+#define LZ4_MINMATCH 4
+#define LZ4_HASH_LOG 12
+#define LZ4_LASTLITERALS 5                                                      // 블록 끝 5바이트는 항상 리터럴 (포맷 규칙)
+#define LZ4_MFLIMIT 12                                                          // 마지막 매치는 끝에서 12바이트 이전에 시작
+#define LZ4_MAX_DISTANCE 65535
+#define LZ4_SKIP_TRIGGER 6
+
+static uint32_t
+lz4_read32(const uint8_t *p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+static uint32_t
+lz4_hash(uint32_t seq)
+{
+    return (seq * 2654435761u) >> (32 - LZ4_HASH_LOG);                          // 4바이트 시퀀스의 곱셈 해시
+}
+static uint8_t *
+lz4_write_length(uint8_t *op, int len)
+{
+    while (len >= 255)                                                          // 15 이상 길이는 255 단위 추가 바이트로 표현
+    {
+        *op++ = 255;
+        len -= 255;
+    }
+    *op++ = (uint8_t)len;
+    return op;
+}
+int
+lz4_compress_block(const uint8_t *src, int src_len, uint8_t *dst, int dst_cap)
+{
+    uint32_t table[1 << LZ4_HASH_LOG];
+    const uint8_t *ip = src;
+    const uint8_t *anchor = src;
+    const uint8_t *iend = src + src_len;
+    const uint8_t *mflimit = iend - LZ4_MFLIMIT;
+    const uint8_t *matchlimit = iend - LZ4_LASTLITERALS;
+    uint8_t *op = dst;
+    uint8_t *oend = dst + dst_cap;
+    if (src_len < 0)
+        return 0;
+    memset(table, 0, sizeof(table));
+    if (src_len >= LZ4_MFLIMIT + 1)
+    {
+        ip++;
+        while (ip < mflimit)
+        {
+            uint32_t h = lz4_hash(lz4_read32(ip));
+            const uint8_t *ref = src + table[h];
+            table[h] = (uint32_t)(ip - src);
+            if (ref >= ip || ip - ref > LZ4_MAX_DISTANCE || lz4_read32(ref) != lz4_read32(ip))
+            {
+                ip += 1 + ((ip - anchor) >> LZ4_SKIP_TRIGGER);                  // 매치가 없을수록 건너뛰는 폭 증가
+                continue;
+            }
+            while (ip > anchor && ref > src && ip[-1] == ref[-1])               // 매치를 뒤쪽으로 확장
+            {
+                ip--;
+                ref--;
+            }
+            const uint8_t *mp = ip + LZ4_MINMATCH;
+            const uint8_t *rp = ref + LZ4_MINMATCH;
+            while (mp < matchlimit && *mp == *rp)                               // 매치를 앞쪽으로 확장
+            {
+                mp++;
+                rp++;
+            }
+            int lit_len = (int)(ip - anchor);
+            int match_len = (int)(mp - ip) - LZ4_MINMATCH;
+            if (op + 1 + lit_len + lit_len / 255 + 1 + 2 + match_len / 255 + 1 > oend)
+                return 0;                                                       // 출력 공간 부족 = 압축 이득 없음
+            uint8_t *token = op++;
+            if (lit_len >= 15)
+            {
+                *token = 15 << 4;
+                op = lz4_write_length(op, lit_len - 15);
+            }
+            else
+                *token = (uint8_t)(lit_len << 4);
+            memcpy(op, anchor, (size_t)lit_len);
+            op += lit_len;
+            uint16_t offset = (uint16_t)(ip - ref);
+            *op++ = (uint8_t)(offset & 0xff);                                   // 오프셋은 little-endian 2바이트
+            *op++ = (uint8_t)(offset >> 8);
+            if (match_len >= 15)
+            {
+                *token |= 15;
+                op = lz4_write_length(op, match_len - 15);
+            }
+            else
+                *token |= (uint8_t)match_len;
+            ip = mp;
+            anchor = ip;
+            if (ip < mflimit)
+                table[lz4_hash(lz4_read32(ip - 2))] = (uint32_t)(ip - 2 - src);
+        }
+    }
+    int last_len = (int)(iend - anchor);                                        // 남은 바이트는 리터럴로 마무리
+    if (op + 1 + last_len + last_len / 255 + 1 > oend)
+        return 0;
+    if (last_len >= 15)
+    {
+        *op++ = 15 << 4;
+        op = lz4_write_length(op, last_len - 15);
+    }
+    else
+        *op++ = (uint8_t)(last_len << 4);
+    memcpy(op, anchor, (size_t)last_len);
+    op += last_len;
+    return (int)(op - dst);
+}
+int
+lz4_decompress_block(const uint8_t *src, int src_len, uint8_t *dst, int dst_cap)
+{
+    const uint8_t *ip = src;
+    const uint8_t *iend = src + src_len;
+    uint8_t *op = dst;
+    uint8_t *oend = dst + dst_cap;
+    while (ip < iend)
+    {
+        uint8_t token = *ip++;
+        size_t lit_len = token >> 4;
+        if (lit_len == 15)
+        {
+            uint8_t b;
+            do
+            {
+                if (ip >= iend)
+                    return -1;
+                b = *ip++;
+                lit_len += b;
+            } while (b == 255);
+        }
+        if (lit_len > (size_t)(iend - ip) || lit_len > (size_t)(oend - op))    // 입력/출력 범위 검증
+            return -1;
+        memcpy(op, ip, lit_len);
+        op += lit_len;
+        ip += lit_len;
+        if (ip >= iend)                                                         // 마지막 시퀀스는 리터럴만 존재
+            break;
+        if (iend - ip < 2)
+            return -1;
+        size_t offset = (size_t)ip[0] | (size_t)ip[1] << 8;
+        ip += 2;
+        if (offset == 0 || offset > (size_t)(op - dst))
+            return -1;
+        size_t match_len = token & 15;
+        if (match_len == 15)
+        {
+            uint8_t b;
+            do
+            {
+                if (ip >= iend)
+                    return -1;
+                b = *ip++;
+                match_len += b;
+            } while (b == 255);
+        }
+        match_len += LZ4_MINMATCH;
+        if (match_len > (size_t)(oend - op))
+            return -1;
+        const uint8_t *match = op - offset;
+        while (match_len--)                                                     // 겹치는 매치(반복 패턴)를 위해 바이트 단위 복사
+            *op++ = *match++;
+    }
+    return (int)(op - dst);
+}
@@ -0,0 +1,403 @@
+#define _GNU_SOURCE
+#include "server_function.h"
+#include <fcntl.h>
+#include <sys/socket.h>
+
+static uint32_t
+proxy_hash(const void *data, size_t len, uint32_t seed)
+{
+    const uint8_t *p = data;
+    uint32_t h = 2166136261u ^ seed;                                            // FNV-1a
+    for (size_t i = 0; i < len; i++)
+    {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    h ^= h >> 16;                                                               // 하위 비트 분산 보강
+    h *= 0x45d9f3bu;
+    h ^= h >> 16;
+    return h;
+}
+static int
+proxy_ring_compare(const void *a, const void *b)
+{
+    const ProxyRingPoint *x = a;
+    const ProxyRingPoint *y = b;
+    return (x->point > y->point) - (x->point < y->point);
+}
+static int
+proxy_parse_backend(const char *spec, struct sockaddr_in *addr)
+{
+    char host[INET_ADDRSTRLEN];
+    const char *colon = strrchr(spec, ':');
+    if (colon == NULL || (size_t)(colon - spec) >= sizeof(host))
+        return -1;
+    memcpy(host, spec, (size_t)(colon - spec));
+    host[colon - spec] = '\0';
+    int port = atoi(colon + 1);
+    if (port <= 0 || port > 65535)
+        return -1;
+    memset(addr, 0, sizeof(*addr));
+    addr->sin_family = AF_INET;
+    addr->sin_port = htons(port);
+    return inet_pton(AF_INET, host, &addr->sin_addr) == 1 ? 0 : -1;
+}
+int
+proxy_init(ServerState *state)
+{
+    const char *list = getenv(PROXY_BACKENDS_ENV);                              // 예: ECHO_PROXY_BACKENDS=127.0.0.1:9191,127.0.0.1:9192
+    if (list == NULL || *list == '\0')
+        return 0;
+    ProxyConfig *proxy = calloc(1, sizeof(ProxyConfig));
+    if (proxy == NULL)
+    {
+        log_message(state, LOG_ERROR, "proxy_init() : calloc() 실패");
+        return -1;
+    }
+    char buf[1024];
+    snprintf(buf, sizeof(buf), "%s", list);
+    char *saveptr = NULL;
+    for (char *tok = strtok_r(buf, ",", &saveptr); tok != NULL; tok = strtok_r(NULL, ",", &saveptr))
+    {
+        if (proxy->backend_count >= PROXY_MAX_BACKENDS)
+        {
+            log_message(state, LOG_WARNING, "proxy_init() : 백엔드는 최대 %d개, '%s' 무시", PROXY_MAX_BACKENDS, tok);
+            continue;
+        }
+        ProxyBackend *backend = &proxy->backends[proxy->backend_count];
+        if (proxy_parse_backend(tok, &backend->addr) == -1)
+        {
+            log_message(state, LOG_ERROR, "proxy_init() : 잘못된 백엔드 주소 '%s'", tok);
+            free(proxy);
+            return -1;
+        }
+        snprintf(backend->name, sizeof(backend->name), "%s", tok);
+        backend->healthy = 1;                                                   // 첫 헬스체크 전까지는 정상으로 간주
+        backend->probe_fd = -1;
+        proxy->backend_count++;
+    }
+    if (proxy->backend_count == 0)
+    {
+        free(proxy);
+        return 0;
+    }
+    const char *policy = getenv(PROXY_POLICY_ENV);
+    proxy->policy = (policy && strcmp(policy, "hash") == 0) ? PROXY_POLICY_HASH : PROXY_POLICY_LEASTCONN;
+    for (int b = 0; b < proxy->backend_count; b++)                              // 일관 해시 링: 백엔드당 가상 노드 PROXY_VNODES개
+    {
+        for (int v = 0; v < PROXY_VNODES; v++)
+        {
+            ProxyRingPoint *pt = &proxy->ring[proxy->ring_size++];
+            pt->point = proxy_hash(proxy->backends[b].name, strlen(proxy->backends[b].name), (uint32_t)v);
+            pt->backend = b;
+        }
+    }
+    qsort(proxy->ring, proxy->ring_size, sizeof(ProxyRingPoint), proxy_ring_compare);
+    state->proxy = proxy;
+    log_message(state, LOG_INFO, "프록시 모드: 백엔드 %d개, 정책 %s", proxy->backend_count, proxy->policy == PROXY_POLICY_HASH ? "consistent-hash" : "least-connections");
+    return 0;
+}
+void
+proxy_cleanup(ServerState *state)
+{
+    for (int b = 0; state->proxy != NULL && b < state->proxy->backend_count; b++)
+    {
+        if (state->proxy->backends[b].probe_fd != -1)
+            close(state->proxy->backends[b].probe_fd);
+    }
+    free(state->proxy);
+    state->proxy = NULL;
+}
+int
+proxy_pick_backend(ServerState *state, const struct sockaddr_in *clnt_addr)
+{
+    ProxyConfig *proxy = state->proxy;
+    int best = -1;
+    if (proxy->policy == PROXY_POLICY_HASH)                                     // 클라이언트 IP 기준 → 같은 백엔드로 고정 (백엔드 증감 시 일부만 이동)
+    {
+        uint32_t h = proxy_hash(&clnt_addr->sin_addr, sizeof(clnt_addr->sin_addr), 0);
+        int lo = 0, hi = proxy->ring_size;
+        while (lo < hi)                                                         // h 이상인 첫 지점 이진 탐색
+        {
+            int mid = (lo + hi) / 2;
+            if (proxy->ring[mid].point < h)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        for (int i = 0; i < proxy->ring_size; i++)                              // 비정상 백엔드는 링의 다음 지점으로
+        {
+            const ProxyRingPoint *pt = &proxy->ring[(lo + i) % proxy->ring_size];
+            if (proxy->backends[pt->backend].healthy)
+                return pt->backend;
+        }
+        return -1;
+    }
+    for (int b = 0; b < proxy->backend_count; b++)                              // least-connections
+    {
+        if (!proxy->backends[b].healthy)
+            continue;
+        if (best == -1 || proxy->backends[b].active < proxy->backends[best].active)
+            best = b;
+    }
+    return best;
+}
+void
+proxy_track_worker(ServerState *state, int backend)
+{
+    ProxyConfig *proxy = state->proxy;
+    proxy->backends[backend].active++;
+    proxy->backends[backend].total++;
+}
+void
+proxy_worker_exited(ServerState *state, int backend)
+{
+    ProxyConfig *proxy = state->proxy;
+    if (proxy == NULL || backend < 0 || backend >= proxy->backend_count)       // 백엔드는 Worker 레지스트리 레코드에서 받음
+        return;
+    proxy->backends[backend].active--;
+}
+static void
+proxy_probe_finish(ServerState *state, ProxyBackend *backend, int ok)
+{
+    if (backend->probe_fd != -1)
+        close(backend->probe_fd);
+    backend->probe_fd = -1;
+    if (ok)
+        backend->fails = 0;
+    else
+        backend->fails++;
+    int healthy = backend->fails < PROXY_HEALTH_FAILS;                          // 연속 실패 횟수로 판정 (일시적 실패에 흔들리지 않게)
+    if (healthy != backend->healthy)
+        log_message(state, healthy ? LOG_INFO : LOG_WARNING, "백엔드 %s 상태 변경: %s (active %d)", backend->name, healthy ? "UP" : "DOWN", backend->active);
+    backend->healthy = healthy;
+}
+void
+proxy_health_check(ServerState *state)
+{
+    ProxyConfig *proxy = state->proxy;
+    if (proxy == NULL)
+        return;
+    if (proxy->probe_deadline_ms != 0)                                          // 진행 중인 프로브: 완료는 proxy_health_handle, 여기서는 시한 초과만 정리
+    {
+        if (timer_wheel_clock_ms() < proxy->probe_deadline_ms)
+            return;
+        for (int b = 0; b < proxy->backend_count; b++)
+        {
+            if (proxy->backends[b].probe_fd != -1)
+                proxy_probe_finish(state, &proxy->backends[b], 0);
+        }
+        proxy->probe_deadline_ms = 0;
+    }
+    time_t now = time(NULL);
+    if (now - proxy->last_health_check < PROXY_HEALTH_INTERVAL)
+        return;
+    proxy->last_health_check = now;
+    int pending = 0;
+    for (int b = 0; b < proxy->backend_count; b++)                              // 모든 백엔드에 동시에 논블로킹 connect (결과는 메인 poll에서 수거)
+    {
+        ProxyBackend *backend = &proxy->backends[b];
+        backend->probe_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (backend->probe_fd == -1)
+            proxy_probe_finish(state, backend, 0);
+        else if (connect(backend->probe_fd, (struct sockaddr *)&backend->addr, sizeof(backend->addr)) == 0)
+            proxy_probe_finish(state, backend, 1);
+        else if (errno != EINPROGRESS)
+            proxy_probe_finish(state, backend, 0);
+        else
+            pending++;
+    }
+    if (pending > 0)
+        proxy->probe_deadline_ms = timer_wheel_clock_ms() + PROXY_CONNECT_TIMEOUT;
+}
+int
+proxy_poll_fill(ServerState *state, struct pollfd *pfds, int max)
+{
+    ProxyConfig *proxy = state->proxy;
+    int n = 0;
+    if (proxy == NULL || proxy->probe_deadline_ms == 0)
+        return 0;
+    for (int b = 0; b < proxy->backend_count && n < max; b++)
+    {
+        if (proxy->backends[b].probe_fd == -1)
+            continue;
+        pfds[n].fd = proxy->backends[b].probe_fd;
+        pfds[n].events = POLLOUT;
+        pfds[n].revents = 0;
+        n++;
+    }
+    return n;
+}
+void
+proxy_health_handle(ServerState *state, const struct pollfd *pfds, int count)
+{
+    ProxyConfig *proxy = state->proxy;
+    if (proxy == NULL)
+        return;
+    for (int n = 0; n < count; n++)
+    {
+        if (pfds[n].revents == 0)
+            continue;
+        for (int b = 0; b < proxy->backend_count; b++)
+        {
+            ProxyBackend *backend = &proxy->backends[b];
+            if (backend->probe_fd != pfds[n].fd)
+                continue;
+            int err = 0;
+            socklen_t len = sizeof(err);
+            proxy_probe_finish(state, backend, getsockopt(backend->probe_fd, SOL_SOCKET, SO_ERROR, &err, &len) == 0 && err == 0);
+            break;
+        }
+    }
+    for (int b = 0; b < proxy->backend_count; b++)                              // 모두 끝났으면 다음 주기까지 프로브 없음
+    {
+        if (proxy->backends[b].probe_fd != -1)
+            return;
+    }
+    proxy->probe_deadline_ms = 0;
+}
+static int
+proxy_connect_backend(const char *spec, int session_id)
+{
+    struct sockaddr_in addr;
+    if (proxy_parse_backend(spec, &addr) == -1)
+    {
+        fprintf(stderr, "proxy_connect_backend() : [자식 #%d] 잘못된 백엔드 '%s'\n", session_id, spec);
+        return -1;
+    }
+    int sock = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (sock == -1)
+        return -1;
+    if (connect(sock, (struct sockaddr *)&addr, sizeof(addr)) == -1)
+    {
+        struct pollfd pfd = {.fd = sock, .events = POLLOUT, .revents = 0};
+        int err = 0;
+        socklen_t len = sizeof(err);
+        if (errno != EINPROGRESS || poll(&pfd, 1, PROXY_CONNECT_TIMEOUT) <= 0 ||
+            getsockopt(sock, SOL_SOCKET, SO_ERROR, &err, &len) == -1 || err != 0)
+        {
+            fprintf(stderr, "proxy_connect_backend() : [자식 #%d] %s 연결 실패: %s\n", session_id, spec, strerror(err ? err : errno));
+            close(sock);
+            return -1;
+        }
+    }
+    return sock;
+}
+static void
+proxy_idle_expired(TimerNode *timer, void *arg)
+{
+    (void)timer;
+    *(int *)arg = 1;
+}
+static int
+proxy_pump(ProxyPipe *dir, int readable)
+{
+    if (readable && !dir->eof && dir->buffered < PROXY_PIPE_SIZE)               // 소켓 → 파이프 (유저 공간 복사 없음)
+    {
+        ssize_t n = splice(dir->from, NULL, dir->pipe[1], NULL, PROXY_PIPE_SIZE - dir->buffered, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+        if (n == 0)
+            dir->eof = 1;
+        else if (n > 0)
+            dir->buffered += (size_t)n;
+        else if (errno != EAGAIN && errno != EINTR)
+            return -1;
+    }
+    if (dir->buffered > 0)                                                      // 파이프 → 반대편 소켓 (EAGAIN이면 다음 POLLOUT에서 재시도)
+    {
+        ssize_t n = splice(dir->pipe[0], NULL, dir->to, NULL, dir->buffered, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+        if (n > 0)
+        {
+            dir->buffered -= (size_t)n;
+            dir->bytes += (unsigned long)n;
+        }
+        else if (n == -1 && errno != EAGAIN && errno != EINTR)
+            return -1;
+    }
+    if (dir->eof && dir->buffered == 0 && !dir->shut)                           // 한쪽 EOF는 반대편에 half-close로 전달
+    {
+        shutdown(dir->to, SHUT_WR);
+        dir->shut = 1;
+    }
+    return 0;
+}
+void
+proxy_session_main(int client_sock, int session_id, const char *backend_spec, ServerState *state)
+{
+    printf("[자식 #%d (PID:%d)] 프록시 세션 시작 → %s\n", session_id, getpid(), backend_spec);
+    int backend_sock = proxy_connect_backend(backend_spec, session_id);
+    if (backend_sock == -1)
+    {
+        close(client_sock);
+        return;
+    }
+    int flags = fcntl(client_sock, F_GETFL);
+    if (flags != -1)
+        fcntl(client_sock, F_SETFL, flags | O_NONBLOCK);
+    ProxyPipe dirs[2] = {{.from = client_sock, .to = backend_sock}, {.from = backend_sock, .to = client_sock}};
+    for (int d = 0; d < 2; d++)
+    {
+        if (pipe2(dirs[d].pipe, O_NONBLOCK | O_CLOEXEC) == -1)
+        {
+            fprintf(stderr, "proxy_session_main() : [자식 #%d] pipe2() 실패: %s\n", session_id, strerror(errno));
+            if (d == 1)
+            {
+                close(dirs[0].pipe[0]);
+                close(dirs[0].pipe[1]);
+            }
+            close(backend_sock);
+            close(client_sock);
+            return;
+        }
+        fcntl(dirs[d].pipe[1], F_SETPIPE_SZ, PROXY_PIPE_SIZE);
+    }
+    TimerWheel wheel;
+    TimerNode idle_timer = {0};
+    int idle_expired = 0;
+    timer_wheel_init(&wheel);
+    timer_arm(&wheel, &idle_timer, SESSION_IDLE_TIMEOUT * 1000L, proxy_idle_expired, &idle_expired);
+    time_t start = time(NULL);
+    while (state->running && !idle_expired && !(dirs[0].shut && dirs[1].shut))
+    {
+        struct pollfd pfds[2] = {{.fd = client_sock}, {.fd = backend_sock}};
+        for (int d = 0; d < 2; d++)                                             // 파이프가 찼으면 읽기 중단 (백프레셔)
+        {
+            if (!dirs[d].eof && dirs[d].buffered < PROXY_PIPE_SIZE)
+                pfds[d].events |= POLLIN;
+            if (dirs[d].buffered > 0)
+                pfds[1 - d].events |= POLLOUT;
+        }
+        int ret = poll(pfds, 2, timer_wheel_next_timeout(&wheel, POLL_TIMEOUT));
+        if (ret == -1 && errno != EINTR)
+        {
+            fprintf(stderr, "proxy_session_main() : [자식 #%d] poll() 실패: %s\n", session_id, strerror(errno));
+            break;
+        }
+        timer_wheel_advance(&wheel);
+        if (ret <= 0)
+            continue;
+        int failed = 0;
+        unsigned long in_before = dirs[0].bytes, out_before = dirs[1].bytes;
+        for (int d = 0; d < 2; d++)
+        {
+            int readable = (pfds[d].revents & (POLLIN | POLLHUP | POLLERR)) != 0;
+            if (proxy_pump(&dirs[d], readable) == -1)
+                failed = 1;
+        }
+        worker_registry_account(state, dirs[0].bytes - in_before, dirs[1].bytes - out_before);
+        worker_registry_activity(state, WORKER_WRITING);                        // 프록시는 읽기/쓰기가 한 번에 일어남
+        if (failed)
+            break;
+        timer_arm(&wheel, &idle_timer, SESSION_IDLE_TIMEOUT * 1000L, proxy_idle_expired, &idle_expired);
+    }
+    timer_cancel(&wheel, &idle_timer);
+    worker_registry_activity(state, WORKER_CLOSING);
+    printf("[자식 #%d (PID:%d)] 프록시 세션 종료%s - client→backend %lu bytes, backend→client %lu bytes, %ld초\n",
+           session_id, getpid(), idle_expired ? " (idle 타임아웃)" : "", dirs[0].bytes, dirs[1].bytes, time(NULL) - start);
+    for (int d = 0; d < 2; d++)
+    {
+        close(dirs[d].pipe[0]);
+        close(dirs[d].pipe[1]);
+    }
+    close(backend_sock);
+    close(client_sock);
+}
@@ -0,0 +1,335 @@
+#include "server_function.h"
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <stddef.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+static int pubsub_tx_fd = -1;                                                   // 발행용 도어벨 송신 소켓 (워커당 1개)
+
+static uint32_t
+pubsub_topic_hash(const uint8_t *topic, size_t len)
+{
+    uint32_t h = 2166136261u;                                                   // FNV-1a
+    for (size_t i = 0; i < len; i++)
+    {
+        h ^= topic[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+static socklen_t
+pubsub_doorbell_addr(const PubSubBus *bus, int slot, struct sockaddr_un *addr)
+{
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    int n = snprintf(addr->sun_path + 1, sizeof(addr->sun_path) - 1, PUBSUB_DOORBELL_FMT, (int)bus->owner, slot);  // abstract namespace: 파일 없음, 프로세스 종료 시 자동 해제 (이름공간은 호스트 전체라 부모 PID 포함)
+    return (socklen_t)(offsetof(struct sockaddr_un, sun_path) + 1 + n);
+}
+static PubSubBus *
+pubsub_map(ServerState *state, pid_t owner, int create)
+{
+    char name[64];
+    snprintf(name, sizeof(name), PUBSUB_SHM_FMT, (int)owner);                  // 부모 PID별: 다른 인스턴스의 참조 수/락/inbox를 덮어쓰지 않음
+    int fd = shm_open(name, create ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDWR, 0600);
+    if (fd == -1)
+    {
+        log_message(state, LOG_ERROR, "pubsub_map() : shm_open(%s) 실패: %s", name, strerror(errno));
+        return NULL;
+    }
+    if (create && ftruncate(fd, sizeof(PubSubBus)) == -1)
+    {
+        log_message(state, LOG_ERROR, "pubsub_map() : ftruncate() 실패: %s", strerror(errno));
+        close(fd);
+        return NULL;
+    }
+    PubSubBus *bus = mmap(NULL, sizeof(PubSubBus), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (bus == MAP_FAILED)
+    {
+        log_message(state, LOG_ERROR, "pubsub_map() : mmap() 실패: %s", strerror(errno));
+        return NULL;
+    }
+    return bus;
+}
+int
+pubsub_create(ServerState *state)
+{
+    state->pubsub = pubsub_map(state, getpid(), 1);                             // 부모: 메시지 풀 + 구독자 inbox 생성
+    if (state->pubsub == NULL)
+        return -1;
+    state->pubsub->owner = getpid();                                            // 도어벨 이름에 사용
+    log_message(state, LOG_INFO, "pub/sub 버스 생성: " PUBSUB_SHM_FMT " (메시지 %d개, 구독자 최대 %d)", (int)getpid(), PUBSUB_POOL_SIZE, PUBSUB_MAX_SUBSCRIBERS);
+    return 0;
+}
+int
+pubsub_attach(ServerState *state)
+{
+    state->pubsub = pubsub_map(state, getppid(), 0);
+    return state->pubsub ? 0 : -1;
+}
+void
+pubsub_destroy(ServerState *state)
+{
+    if (state->pubsub == NULL)
+        return;
+    munmap(state->pubsub, sizeof(PubSubBus));
+    state->pubsub = NULL;
+    if (getpid() == state->parent_pid)
+    {
+        char name[64];
+        snprintf(name, sizeof(name), PUBSUB_SHM_FMT, (int)getpid());
+        shm_unlink(name);
+    }
+    if (pubsub_tx_fd != -1)
+    {
+        close(pubsub_tx_fd);
+        pubsub_tx_fd = -1;
+    }
+}
+static int
+pubsub_lock(PubSubSubscriber *sub, int wait)
+{
+    pid_t self = getpid();
+    for (int spins = 1;; spins++)
+    {
+        pid_t holder = 0;
+        if (atomic_compare_exchange_weak_explicit(&sub->lock, &holder, self, memory_order_acquire, memory_order_relaxed))
+            return 0;
+        if (spins % PUBSUB_LOCK_SPINS != 0)
+            continue;                                                           // 임계 구역은 inbox 1칸 기록뿐이라 짧게 스핀
+        if (holder > 0 && kill(holder, 0) == -1 && errno == ESRCH)
+            atomic_compare_exchange_strong(&sub->lock, &holder, 0);             // 락을 잡은 채 죽은 발행자: 소유자 PID로 판별해 회수
+        else if (!wait)
+            return -1;                                                          // 부모: 회수 전 좀비는 kill로 구분 불가, 기다리지 않고 다음 회수로 미룸
+        sched_yield();
+    }
+}
+static void
+pubsub_unlock(PubSubSubscriber *sub)
+{
+    atomic_store_explicit(&sub->lock, 0, memory_order_release);
+}
+void
+pubsub_release(ServerState *state, uint32_t idx)
+{
+    atomic_fetch_sub_explicit(&state->pubsub->msgs[idx].refcnt, 1, memory_order_acq_rel);  // 0이 되면 풀에 반환된 것으로 간주
+}
+static int
+pubsub_disown(PubSubMessage *msg, pid_t owner)
+{
+    uint64_t ref = atomic_load(&msg->refcnt);
+    while (ref >> 32 == (uint32_t)owner)                                        // 소유자 표시와 발행자 참조를 한 번에 반납
+    {
+        if (atomic_compare_exchange_weak_explicit(&msg->refcnt, &ref, (uint32_t)ref - 1, memory_order_acq_rel, memory_order_relaxed))
+            return 1;
+    }
+    return 0;
+}
+static int
+pubsub_detach_slot(PubSubBus *bus, int slot, int wait)
+{
+    PubSubSubscriber *sub = &bus->subs[slot];
+    if (pubsub_lock(sub, wait) == -1)                                           // 기록 중인 발행자가 끝날 때까지 대기
+        return -1;
+    pubsub_unlock(sub);
+    uint32_t head = atomic_load(&sub->head);
+    uint32_t tail = atomic_load(&sub->tail);
+    for (; head != tail; head++)                                                // 전달 못한 메시지의 참조 반납
+        atomic_fetch_sub_explicit(&bus->msgs[sub->inbox[head % PUBSUB_INBOX_SIZE]].refcnt, 1, memory_order_acq_rel);
+    atomic_store(&sub->head, head);
+    atomic_store_explicit(&sub->state, PUBSUB_SUB_FREE, memory_order_release);
+    return 0;
+}
+int
+pubsub_subscribe(ServerState *state, SessionDescriptor *session, const uint8_t *topic, uint32_t len)
+{
+    PubSubBus *bus = state->pubsub;
+    if (bus == NULL || len == 0 || len >= PUBSUB_TOPIC_MAX)
+        return -1;
+    pubsub_unsubscribe(state, session);                                         // 세션당 토픽 1개: 재구독은 교체
+    for (int slot = 0; slot < PUBSUB_MAX_SUBSCRIBERS; slot++)
+    {
+        PubSubSubscriber *sub = &bus->subs[slot];
+        uint32_t expected = PUBSUB_SUB_FREE;
+        if (!atomic_compare_exchange_strong(&sub->state, &expected, PUBSUB_SUB_CLAIMED))
+            continue;
+        sub->pid = getpid();                                                    // 구독 도중 죽어도 pubsub_reap()이 슬롯을 찾을 수 있게 먼저 기록
+        int fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);   // 도어벨: inbox가 비어 있다가 채워질 때만 울림
+        struct sockaddr_un addr;
+        socklen_t addr_len = pubsub_doorbell_addr(bus, slot, &addr);
+        if (fd == -1 || bind(fd, (struct sockaddr *)&addr, addr_len) == -1)
+        {
+            fprintf(stderr, "pubsub_subscribe() : [자식 #%d] 도어벨 소켓 실패: %s\n", session->session_id, strerror(errno));
+            if (fd != -1)
+                close(fd);
+            atomic_store(&sub->state, PUBSUB_SUB_FREE);
+            return -1;
+        }
+        sub->session_id = session->session_id;
+        sub->topic_len = len;
+        memcpy(sub->topic, topic, len);
+        sub->topic[len] = '\0';
+        sub->topic_hash = pubsub_topic_hash(topic, len);
+        atomic_store(&sub->head, 0);
+        atomic_store(&sub->tail, 0);
+        atomic_store(&sub->dropped, 0);
+        atomic_store_explicit(&sub->state, PUBSUB_SUB_ACTIVE, memory_order_release);
+        uint32_t hw = atomic_load(&bus->high_water);
+        while (hw < (uint32_t)slot + 1 && !atomic_compare_exchange_weak(&bus->high_water, &hw, (uint32_t)slot + 1))  // 발행 시 스캔 범위
+            ;
+        session->pubsub_slot = slot;
+        session->doorbell = fd;
+        printf("[자식 #%d] 구독: '%s' (slot %d)\n", session->session_id, sub->topic, slot);
+        return 0;
+    }
+    fprintf(stderr, "pubsub_subscribe() : [자식 #%d] 구독자 슬롯 없음\n", session->session_id);
+    return -1;
+}
+void
+pubsub_unsubscribe(ServerState *state, SessionDescriptor *session)
+{
+    if (state->pubsub == NULL || session->pubsub_slot < 0)
+        return;
+    session->pubsub_dropped += atomic_load(&state->pubsub->subs[session->pubsub_slot].dropped);
+    atomic_store(&state->pubsub->subs[session->pubsub_slot].state, PUBSUB_SUB_CLOSING);   // 새 발행자는 이 슬롯을 건너뜀
+    pubsub_detach_slot(state->pubsub, session->pubsub_slot, 1);
+    close(session->doorbell);
+    session->doorbell = -1;
+    session->pubsub_slot = -1;
+}
+void
+pubsub_reap(ServerState *state, pid_t pid)
+{
+    PubSubBus *bus = state->pubsub;
+    if (bus == NULL)
+        return;
+    uint32_t hw = atomic_load(&bus->high_water);
+    for (uint32_t slot = 0; slot < hw; slot++)                                  // 정리 없이 죽은 구독자가 잡고 있던 참조 회수
+    {
+        PubSubSubscriber *sub = &bus->subs[slot];
+        pid_t holder = pid;
+        atomic_compare_exchange_strong(&sub->lock, &holder, 0);                 // 락을 잡은 채 죽은 발행자: 회수됐으니 바로 해제
+        uint32_t sub_state = atomic_load(&sub->state);
+        if (sub->pid != pid || sub_state == PUBSUB_SUB_FREE || sub_state == PUBSUB_SUB_REAPING)
+            continue;
+        atomic_store(&sub->state, PUBSUB_SUB_REAPING);                          // 새 발행자는 이 슬롯을 건너뜀
+        log_message(state, LOG_WARNING, "pubsub_reap() : 종료된 워커(PID:%d)의 구독 slot %u 회수", pid, slot);
+    }
+    int pending = 0;
+    for (uint32_t slot = 0; slot < hw; slot++)                                  // 이번 회수 + 락이 잡혀 있어 이전 회수에서 미룬 슬롯
+    {
+        if (atomic_load(&bus->subs[slot].state) == PUBSUB_SUB_REAPING && pubsub_detach_slot(bus, (int)slot, 0) == -1)
+            pending++;
+    }
+    unsigned long reclaimed = 0;
+    for (int i = 0; i < PUBSUB_POOL_SIZE; i++)                                  // 발행 도중 죽은 워커가 확보해 둔 버퍼 반납
+        reclaimed += pubsub_disown(&bus->msgs[i], pid);
+    if (reclaimed > 0 || pending > 0)
+        log_message(state, LOG_WARNING, "pubsub_reap() : 종료된 워커(PID:%d)의 메시지 버퍼 %lu개 회수, 락이 잡혀 미룬 slot %d개", pid, reclaimed, pending);
+}
+long
+pubsub_publish(ServerState *state, SessionDescriptor *session, const uint8_t *payload, uint32_t len)
+{
+    PubSubBus *bus = state->pubsub;
+    if (bus == NULL || len < 2 || len > PUBSUB_MSG_MAX)                         // [토픽 길이 1][토픽][본문]
+        return -1;
+    uint32_t topic_len = payload[0];
+    if (topic_len == 0 || topic_len >= PUBSUB_TOPIC_MAX || 1 + topic_len > len)
+        return -1;
+    const uint8_t *topic = payload + 1;
+    pid_t self = getpid();
+    uint32_t idx = 0;
+    PubSubMessage *msg = NULL;
+    for (int tries = 0; tries < PUBSUB_POOL_SIZE && msg == NULL; tries++)       // refcnt 0인 버퍼를 CAS로 확보
+    {
+        idx = atomic_fetch_add_explicit(&bus->next_msg, 1, memory_order_relaxed) % PUBSUB_POOL_SIZE;
+        uint64_t expected = 0;
+        if (atomic_compare_exchange_strong(&bus->msgs[idx].refcnt, &expected, PUBSUB_REF_OWNER(self) | 1))   // 소유자 PID를 참조 수와 한 워드에: 발행 도중 죽으면 부모가 회수
+            msg = &bus->msgs[idx];
+    }
+    if (msg == NULL)
+    {
+        fprintf(stderr, "pubsub_publish() : [자식 #%d] 메시지 풀 고갈\n", session->session_id);
+        return -1;
+    }
+    memcpy(msg->data, payload, len);                                            // 본문은 여기 한 번만 복사, 구독자에게는 인덱스만 전달
+    msg->len = len;
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    uint32_t hash = pubsub_topic_hash(topic, topic_len);
+    uint32_t hw = atomic_load(&bus->high_water);
+    long delivered = 0;
+    unsigned long dropped = 0;
+    for (uint32_t slot = 0; slot < hw; slot++)
+    {
+        PubSubSubscriber *sub = &bus->subs[slot];
+        if (atomic_load_explicit(&sub->state, memory_order_relaxed) != PUBSUB_SUB_ACTIVE || sub->topic_hash != hash)
+            continue;
+        int ring = 0;
+        pubsub_lock(sub, 1);
+        if (atomic_load(&sub->state) == PUBSUB_SUB_ACTIVE && sub->topic_len == topic_len && memcmp(sub->topic, topic, topic_len) == 0)
+        {
+            uint32_t tail = atomic_load_explicit(&sub->tail, memory_order_relaxed);
+            if (tail - atomic_load(&sub->head) >= PUBSUB_INBOX_SIZE)            // 느린 구독자: 발행자를 막지 않고 드롭
+            {
+                atomic_fetch_add(&sub->dropped, 1);
+                dropped++;
+            }
+            else
+            {
+                atomic_fetch_add_explicit(&msg->refcnt, 1, memory_order_relaxed);
+                sub->inbox[tail % PUBSUB_INBOX_SIZE] = idx;
+                atomic_store(&sub->tail, tail + 1);
+                ring = atomic_load(&sub->head) == tail;                         // 비어 있던 inbox일 때만 깨움 (tail 기록 후 head 확인)
+                delivered++;
+            }
+        }
+        pubsub_unlock(sub);
+        if (ring)
+        {
+            if (pubsub_tx_fd == -1)
+                pubsub_tx_fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            struct sockaddr_un addr;
+            socklen_t addr_len = pubsub_doorbell_addr(bus, (int)slot, &addr);
+            char bell = 1;
+            sendto(pubsub_tx_fd, &bell, 1, MSG_DONTWAIT, (struct sockaddr *)&addr, addr_len);  // EAGAIN이면 이미 울린 도어벨이 남아 있음
+        }
+    }
+    pubsub_disown(msg, self);                                                   // 발행자 자신의 참조 반납
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    session->fanout_ms += (t1.tv_sec - t0.tv_sec) * 1000.0 + (t1.tv_nsec - t0.tv_nsec) / 1e6;
+    session->published++;
+    session->fanout += (unsigned long)delivered;
+    session->pubsub_dropped += dropped;
+    atomic_fetch_add(&bus->published, 1);
+    atomic_fetch_add(&bus->delivered, (unsigned long)delivered);
+    atomic_fetch_add(&bus->dropped, dropped);
+    return delivered;
+}
+static void
+pubsub_clear_doorbell(SessionDescriptor *session)
+{
+    char bells[64];
+    while (recv(session->doorbell, bells, sizeof(bells), MSG_DONTWAIT) > 0)
+        ;
+}
+const PubSubMessage *
+pubsub_next(ServerState *state, SessionDescriptor *session, uint32_t *idx)
+{
+    if (state->pubsub == NULL || session->pubsub_slot < 0)
+        return NULL;
+    PubSubSubscriber *sub = &state->pubsub->subs[session->pubsub_slot];
+    uint32_t head = atomic_load_explicit(&sub->head, memory_order_relaxed);
+    if (head == atomic_load(&sub->tail))
+    {
+        pubsub_clear_doorbell(session);                                         // 비우고 다시 확인: 이후 들어온 메시지는 새 도어벨로 깨움
+        if (head == atomic_load(&sub->tail))
+            return NULL;
+    }
+    *idx = sub->inbox[head % PUBSUB_INBOX_SIZE];
+    atomic_store(&sub->head, head + 1);
+    return &state->pubsub->msgs[*idx];                                          // 호출자가 전송 후 pubsub_release()로 참조 반납
+}
@@ -1,3 +1,4 @@
+#define LOG_MODULE LOG_MODULE_MONITOR
 #include "server_function.h"
 #include <sys/resource.h>
 #include <dirent.h>
@@ -8,9 +9,9 @@ get_heap_usage(void)
 {
 #ifdef __GLIBC__
     struct mallinfo2 mi = mallinfo2();
-    return (long)mi.uordblks;
+    return (long)mi.uordblks + (long)arena_live_usage();                        // malloc 힙 + 세션 아레나(mmap) 사용량
 #else
-    return 0;
+    return (long)arena_live_usage();
 #endif
 }
 int 
@@ -38,6 +39,8 @@ monitor_resources(ResourceMonitor *monitor)
     if (monitor == NULL)
         return;
     monitor->heap_usage = get_heap_usage();
+    monitor->arena_live = (long)arena_live_usage();
+    monitor->arena_mapped = (long)arena_mapped_usage();
     monitor->open_fds = count_open_fds();
 }
 void 
@@ -55,6 +58,7 @@ print_resource_status(ResourceMonitor *monitor)
         printf("힙 메모리 사용: %ld bytes (%.2f KB)\n", monitor->heap_usage, monitor->heap_usage / 1024.0);
     else
         printf("힙 메모리 사용: 측정 불가\n");
+    printf("세션 아레나: %ld bytes 사용 / %ld bytes 매핑\n", monitor->arena_live, monitor->arena_mapped);
     if (monitor->open_fds >= 0)
         printf("열린 FD: %d개\n", monitor->open_fds);
     else
@@ -0,0 +1,134 @@
+#define _DEFAULT_SOURCE
+#include "server_function.h"
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+
+#define SCOREBOARD_STUCK_MS 10000
+
+static uint64_t
+scoreboard_clock_ms(void)
+{
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC_COARSE, &ts) == -1)                       // 서버의 timer_wheel_clock_ms()와 같은 시계
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+static int
+scoreboard_by_age(const void *a, const void *b)
+{
+    uint64_t la = ((const WorkerRecord *)a)->last_activity_ms;
+    uint64_t lb = ((const WorkerRecord *)b)->last_activity_ms;
+    return la < lb ? -1 : la > lb;                                              // 가장 오래 멈춘 Worker 먼저
+}
+static int
+scoreboard_show(int server_pid, int limit, int summary_only)
+{
+    static const char *const names[WORKER_ACTIVITY_COUNT] = {"STARTING", "IDLE", "READING", "WRITING", "CLOSING"};
+    char name[64];
+    snprintf(name, sizeof(name), WORKER_REGISTRY_SHM_FMT, server_pid);
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd == -1)
+    {
+        fprintf(stderr, "scoreboard_show() : shm_open(%s) 실패: %s\n", name, strerror(errno));
+        return -1;
+    }
+    const WorkerRecordTable *table = mmap(NULL, sizeof(WorkerRecordTable), PROT_READ, MAP_SHARED, fd, 0);   // 읽기 전용: Worker에 영향 없음
+    close(fd);
+    if (table == MAP_FAILED)
+    {
+        fprintf(stderr, "scoreboard_show() : mmap() 실패: %s\n", strerror(errno));
+        return -1;
+    }
+    WorkerRecord *live = malloc(sizeof(WorkerRecord) * MAX_WORKERS);
+    if (live == NULL)
+    {
+        munmap((void *)table, sizeof(WorkerRecordTable));
+        return -1;
+    }
+    int count = 0, by_activity[WORKER_ACTIVITY_COUNT] = {0}, stuck = 0;
+    uint64_t now = scoreboard_clock_ms(), bytes_in = 0, bytes_out = 0;
+    for (int r = 0; r < MAX_WORKERS; r++)                                       // 스냅샷 복사 (Worker는 계속 갱신 중)
+    {
+        if (atomic_load_explicit(&table->records[r].pid, memory_order_relaxed) == 0)
+            continue;
+        memcpy(&live[count], &table->records[r], sizeof(WorkerRecord));
+        WorkerRecord *rec = &live[count++];
+        uint8_t activity = rec->activity;
+        if (activity < WORKER_ACTIVITY_COUNT)
+            by_activity[activity]++;
+        if ((activity == WORKER_READING || activity == WORKER_WRITING) && now - rec->last_activity_ms > SCOREBOARD_STUCK_MS)
+            stuck++;
+        bytes_in += rec->bytes_in;
+        bytes_out += rec->bytes_out;
+    }
+    munmap((void *)table, sizeof(WorkerRecordTable));
+    printf("서버 PID %d: Worker %d개 |", server_pid, count);
+    for (int a = 0; a < WORKER_ACTIVITY_COUNT; a++)
+        printf(" %s %d", names[a], by_activity[a]);
+    printf(" | 정체 %d | in %llu / out %llu bytes\n", stuck, (unsigned long long)bytes_in, (unsigned long long)bytes_out);
+    if (!summary_only && count > 0)
+    {
+        qsort(live, count, sizeof(WorkerRecord), scoreboard_by_age);
+        printf("%8s %-8s %9s %8s %-21s %8s %12s %12s %9s\n", "PID", "STATE", "LAST(s)", "SESSION", "CLIENT", "I/O", "IN", "OUT", "AGE(s)");
+        for (int i = 0; i < count && i < limit; i++)
+        {
+            WorkerRecord *rec = &live[i];
+            char ip[INET_ADDRSTRLEN], client[32];
+            inet_ntop(AF_INET, &rec->addr.sin_addr, ip, sizeof(ip));
+            snprintf(client, sizeof(client), "%s:%d", ip, ntohs(rec->addr.sin_port));
+            uint8_t activity = rec->activity;
+            int is_stuck = (activity == WORKER_READING || activity == WORKER_WRITING) && now - rec->last_activity_ms > SCOREBOARD_STUCK_MS;
+            printf("%8d %-8s %9.1f %8d %-21s %8u %12llu %12llu %9.1f%s\n", rec->pid,
+                   activity < WORKER_ACTIVITY_COUNT ? names[activity] : "?", (now - rec->last_activity_ms) / 1000.0,
+                   rec->session_id, client, rec->io_count, (unsigned long long)rec->bytes_in, (unsigned long long)rec->bytes_out,
+                   (now - rec->spawn_ms) / 1000.0, is_stuck ? "  <- 정체" : "");
+        }
+        if (count > limit)
+            printf("... 외 %d개 (-n으로 조정)\n", count - limit);
+    }
+    free(live);
+    return 0;
+}
+int
+main(int argc, char *argv[])
+{
+    int limit = 50, summary_only = 0, server_pid = 0, opt;
+    while ((opt = getopt(argc, argv, "n:s")) != -1)
+    {
+        if (opt == 'n')
+            limit = atoi(optarg);
+        else if (opt == 's')
+            summary_only = 1;
+        else
+        {
+            fprintf(stderr, "사용법: %s [-s] [-n 행수] [서버 PID]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (optind < argc)
+        server_pid = atoi(argv[optind]);
+    if (server_pid > 0)
+        return scoreboard_show(server_pid, limit, summary_only) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    DIR *dir = opendir("/dev/shm");                                              // PID 생략 시 실행 중인 모든 서버
+    if (dir == NULL)
+    {
+        fprintf(stderr, "main() : opendir(/dev/shm) 실패: %s\n", strerror(errno));
+        return EXIT_FAILURE;
+    }
+    struct dirent *entry;
+    int found = 0;
+    while ((entry = readdir(dir)) != NULL)
+    {
+        int pid;
+        if (sscanf(entry->d_name, "echo_workers.%d", &pid) == 1 && scoreboard_show(pid, limit, summary_only) == 0)
+            found++;
+    }
+    closedir(dir);
+    if (found == 0)
+    {
+        fprintf(stderr, "main() : 실행 중인 서버의 스코어보드를 찾지 못함\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -10,7 +10,12 @@
 #include <string.h>
 #include <signal.h>
 #include <sys/wait.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <semaphore.h>
 #include <arpa/inet.h>
+#include "lz4_block.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -23,6 +28,149 @@ extern "C" {
 #define POLL_TIMEOUT 1000
 #define SESSION_IDLE_TIMEOUT 60
 #define MAX_FRAMES 64
+#define WRITE_STALL_TIMEOUT 5000
+#define SHUTDOWN_GRACE_PERIOD 5
+#define TIMER_TICK_MS 10
+#define TW_SLOT_BITS 6
+#define TW_SLOTS (1 << TW_SLOT_BITS)
+#define TW_LEVELS 4
+#define TLS_CERT_FILE "server.crt"
+#define TLS_KEY_FILE "server.key"
+#define TLS_TICKET_KEY_FILE "tls_ticket.key"
+#define TLS_TICKET_SHM_FMT "/echo_tls_ticket.%d"
+#define TLS_TICKET_KEY_LEN 80
+#define TLS_TICKET_LIFETIME 300
+#define TLS_HANDSHAKE_TIMEOUT 5000
+#define FRAME_MAGIC 0xFE
+#define FRAME_HEADER_SIZE 8
+#define FRAME_CRC_SIZE 4
+#define FRAME_MAX_PAYLOAD 16384
+#define FRAME_BUF_SIZE (FRAME_HEADER_SIZE + FRAME_MAX_PAYLOAD + FRAME_CRC_SIZE)
+#define FRAME_TYPE_DATA 1
+#define FRAME_TYPE_HELLO 2
+#define FRAME_FLAG_CRC 0x01
+#define FRAME_FLAG_LZ4 0x02
+#define FRAME_CAP_LZ4 0x01
+#define FRAME_SERVER_CAPS (FRAME_CAP_LZ4 | FRAME_CAP_RESUME)
+#define FRAME_LZ4_PREFIX 4
+#define FRAME_CAP_RESUME 0x02
+#define SESSION_TABLE_SHM_FMT "/echo_sessions.%d"
+#define SESSION_TABLE_SIZE 4096
+#define SESSION_TABLE_PROBE_LIMIT 64
+#define SESSION_RESUME_WINDOW 30
+#define SESSION_RESUME_OUTBUF 1024
+#define SESSION_SLOT_WORD(st, pid) ((uint64_t)(uint32_t)(pid) << 32 | (uint32_t)(st))
+#define BUSY_POLL_ENV "ECHO_BUSY_POLL"
+#define BUSY_POLL_USEC 50
+#define BUSY_POLL_BUDGET_MS 200
+#define BUSY_POLL_CLOCK_CHECK 1024
+#define PORT_ENV "ECHO_PORT"
+#define PROXY_BACKENDS_ENV "ECHO_PROXY_BACKENDS"
+#define PROXY_POLICY_ENV "ECHO_PROXY_POLICY"
+#define PROXY_BACKEND_ENV "ECHO_BACKEND"
+#define PROXY_MAX_BACKENDS 32
+#define PROXY_VNODES 64
+#define PROXY_HEALTH_INTERVAL 2
+#define PROXY_HEALTH_FAILS 2
+#define PROXY_CONNECT_TIMEOUT 200
+#define PROXY_PIPE_SIZE 65536
+#define FRAME_TYPE_SUBSCRIBE 3
+#define FRAME_TYPE_UNSUBSCRIBE 4
+#define FRAME_TYPE_PUBLISH 5
+#define FRAME_TYPE_MESSAGE 6
+#define PUBSUB_SHM_FMT "/echo_pubsub.%d"
+#define PUBSUB_POOL_SIZE 4096
+#define PUBSUB_MSG_MAX 1024
+#define PUBSUB_MAX_SUBSCRIBERS 16384
+#define PUBSUB_INBOX_SIZE 128
+#define PUBSUB_TOPIC_MAX 32
+#define PUBSUB_DOORBELL_FMT "echo_pubsub.%d.%d"
+#define PUBSUB_REF_OWNER(pid) ((uint64_t)(uint32_t)(pid) << 32)
+#define PUBSUB_LOCK_SPINS 1024
+#define TCP_TELEMETRY_SHM_FMT "/echo_telemetry.%d"
+#define TCP_INFO_ENV "ECHO_TCP_INFO_MS"
+#define TCP_INFO_INTERVAL_MS 1000
+#define TCP_RTT_BUCKETS 32
+#define ARENA_CHUNK_SIZE (128 * 1024)
+#define ARENA_ALIGN 16
+#define ARENA_FREE_MAX 4
+#define COMMAND_HASH_SIZE 16
+#define COMMAND_TOKEN_MAX 16
+#define COMMAND_SLEEP_MAX_MS 10000
+#define WORKER_REGISTRY_SHM_FMT "/echo_workers.%d"
+#define WORKER_SLOT_ENV "ECHO_WORKER_SLOT"
+#define WORKER_INDEX_BITS 14
+#define WORKER_INDEX_SIZE (1 << WORKER_INDEX_BITS)
+#define SHUTDOWN_DUMP_LIMIT 20
+#define SHUTDOWN_GRACE_ENV "ECHO_SHUTDOWN_GRACE_MS"
+#define SHUTDOWN_GRACE_PER_WORKER_US 500
+#define SHUTDOWN_GRACE_MAX 30
+#define SHUTDOWN_PROGRESS_MS 1000
+#define SHUTDOWN_KILL_WAIT_MS 2000
+#define CRASH_IP_TABLE_BITS 10
+#define CRASH_IP_TABLE_SIZE (1 << CRASH_IP_TABLE_BITS)
+#define CRASH_IP_WINDOW 60
+#define CRASH_IP_THRESHOLD 3
+#define CRASH_QUARANTINE_SEC 30
+#define CRASH_QUARANTINE_MAX 600
+#define CRASH_STORM_THRESHOLD 10
+#define CRASH_STORM_WINDOW_MS 10000
+#define CRASH_BACKOFF_BASE_MS 100
+#define CRASH_BACKOFF_MAX_MS 5000
+#define CRASH_RING_SHM_FMT "/echo_crashes.%d"
+#define CRASH_RING_SIZE 64
+#define CRASH_RECORD_FRAMES 32
+#define CRASH_STACKS_MAX 64
+#define CRASH_WORKER_BINARY "./worker"
+#define POOL_ENV "ECHO_WORKER_POOL"
+#define POOL_MAX_SESSIONS_ENV "ECHO_POOL_MAX_SESSIONS"
+#define POOL_MAX_RSS_ENV "ECHO_POOL_MAX_RSS_KB"
+#define POOL_MAX_AGE_ENV "ECHO_POOL_MAX_AGE"
+#define POOL_MAX_WORKERS 64
+#define POOL_SLOTS (POOL_MAX_WORKERS * 2)
+#define POOL_MAX_SESSIONS 1000
+#define POOL_MAX_RSS_KB (64 * 1024)
+#define POOL_MAX_AGE 3600
+#define POOL_CHANNEL_FD 3
+#define POOL_STANDBY_ENV "ECHO_WORKER_STANDBY"
+#define START_ACCEPT_ENV "ECHO_ACCEPT_US"
+#define START_LATENCY_BUCKETS 32
+#define LOG_SYNC_ENV "ECHO_LOG_SYNC"
+#define LOG_SHM_FMT "/echo_log.%d"
+#define LOG_RING_SIZE 8192
+#define LOG_RECORD_MAX 484
+#define LOG_LINE_MAX 560
+#define LOG_WRITE_BUF (64 * 1024)
+#define LOG_STALL_MS 100
+#define LOG_OWNER(pos, pid) ((((uint64_t)(pos) / LOG_RING_SIZE + 1) << 32) | (uint32_t)(pid))
+#define LOG_BINARY_ENV "ECHO_LOG_BINARY"
+#define LOG_BINARY_FILE "server.blog"
+#define LOG_BINARY_MAGIC "ECHOLOG2"
+#define LOG_SITE_ARGS 16
+#define LOG_SITES_MAX 1024
+#define LOG_SUPPRESS_REPORT_MS 5000
+#define LOG_ACCEPT_RETRY_PER_SEC 10
+#define LOG_POLL_TIMEOUT_PER_SEC 1
+#define LOG_IO_SAMPLE 100
+#define LOG_LEVELS_ENV "ECHO_LOG_LEVELS"
+#define LOG_LEVELS_FILE "log_levels.conf"
+#define LOG_ROTATE_MB_ENV "ECHO_LOG_ROTATE_MB"
+#define LOG_ROTATE_SECS_ENV "ECHO_LOG_ROTATE_SECS"
+#define LOG_ROTATE_MB 64
+#define LOG_ROTATE_SECS 86400
+#define LOG_COMPRESS_JOBS 4
+#define LOG_COMPRESS_DELAY_SEC 2
+#define LOG_PATH_MAX 128
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL LOG_DEBUG
+#endif
+#ifndef LOG_MODULE
+#define LOG_MODULE LOG_MODULE_CORE
+#endif
+#define LOG_FLUSH_INTERVAL_MS 10
+#define LOG_IDLE_ROUNDS 100
+#define LOG_IDLE_SLEEP_MS 60000
+#define LOG_BLOCK_SPINS 10000
 typedef enum 
 {
     SESSION_IDLE = 0,
@@ -32,26 +180,554 @@ typedef enum
 } SessionState;
 typedef enum 
 {
+    LOG_DEBUG = 0,
     LOG_INFO,
+    LOG_WARNING,
     LOG_ERROR,
-    LOG_DEBUG,
-    LOG_WARNING
+    LOG_OFF
 } LogLevel;
+typedef enum 
+{
+    LOG_MODULE_CORE = 0,
+    LOG_MODULE_ACCEPT,
+    LOG_MODULE_WORKER,
+    LOG_MODULE_SHUTDOWN,
+    LOG_MODULE_MONITOR,
+    LOG_MODULES
+} LogModule;
+typedef enum 
+{
+    LOG_KIND_TEXT = 0,
+    LOG_KIND_BINARY,
+    LOG_KIND_DEFINE
+} LogKind;
+typedef enum 
+{
+    LOG_ARG_NONE = 0,
+    LOG_ARG_INT,
+    LOG_ARG_LONG,
+    LOG_ARG_DOUBLE,
+    LOG_ARG_STRING,
+    LOG_ARG_POINTER
+} LogArgType;
+typedef struct 
+{
+    uint8_t type;
+    uint8_t star_width;
+    uint8_t star_prec;
+    int16_t prec;
+} LogArgSpec;
+typedef struct LogSite LogSite;
+struct LogSite
+{
+    const char *file;
+    int line;
+    int module;
+    _Atomic int ready;
+    int defined;
+    uint32_t id;
+    int argc;
+    LogArgSpec args[LOG_SITE_ARGS];
+    uint32_t limit;
+    uint32_t sample;
+    uint32_t window_count;
+    int level;
+    uint64_t calls;
+    uint64_t window_ms;
+    uint64_t suppressed;
+    uint64_t suppressed_total;
+    uint64_t report_ms;
+    LogSite *next;
+};
+typedef struct 
+{
+    _Atomic uint64_t seq;
+    _Atomic uint64_t owner;
+    uint64_t time_ns;
+    pid_t pid;
+    uint32_t site;
+    uint8_t kind;
+    uint8_t level;
+    uint16_t len;
+    char msg[LOG_RECORD_MAX];
+} LogRecord;
+typedef struct 
+{
+    uint8_t kind;
+    uint8_t level;
+    uint16_t len;
+    uint32_t site;
+    int32_t pid;
+    uint32_t reserved;
+    uint64_t time_ns;
+} LogDiskRecord;
+typedef struct 
+{
+    uint32_t id;
+    uint16_t len;
+    char *data;
+} LogSiteDef;
+typedef struct 
+{
+    pid_t pid;
+    int pidfd;
+    uint64_t due_ms;
+    char path[LOG_PATH_MAX];
+} LogCompressJob;
+typedef struct 
+{
+    _Alignas(64) _Atomic uint64_t head;
+    _Alignas(64) _Atomic uint64_t dropped;
+    _Atomic int sleeping;
+    int binary;
+    _Atomic uint8_t levels[LOG_MODULES];
+    sem_t wake;
+    LogRecord records[LOG_RING_SIZE];
+} LogRing;
+typedef struct 
+{
+    LogRing *ring;
+    int shared;
+    uint64_t tail;
+    _Atomic int consumer;
+    _Atomic int running;
+    uint64_t written;
+    uint64_t skipped;
+    uint64_t dropped_reported;
+    uint64_t stall_since_ms;
+    uint64_t bytes;
+    uint64_t file_bytes;
+    uint64_t rotate_bytes;
+    uint64_t rotate_ms;
+    uint64_t opened_ms;
+    uint64_t rotations;
+    int fd;
+    int binary;
+    int crashing;
+    LogSiteDef sites[LOG_SITES_MAX];
+    int site_count;
+    LogCompressJob compress[LOG_COMPRESS_JOBS];
+    long gmtoff;
+    time_t gmtoff_minute;
+    pthread_t thread;
+} LogWriter;
+struct ssl_st;
+struct ssl_ctx_st;
+typedef struct TimerNode TimerNode;
+typedef void (*TimerCallback)(TimerNode *timer, void *arg);
+struct TimerNode
+{
+    TimerNode *next;
+    TimerNode *prev;
+    uint64_t expires;
+    TimerCallback callback;
+    void *arg;
+};
+typedef struct 
+{
+    uint64_t current_tick;
+    uint64_t now_ms;
+    int armed_count;
+    TimerNode slots[TW_LEVELS][TW_SLOTS];
+} TimerWheel;
+typedef enum 
+{
+    SESSION_SLOT_EMPTY = 0,
+    SESSION_SLOT_OWNED,
+    SESSION_SLOT_PARKED
+} SessionSlotState;
+typedef struct 
+{
+    _Atomic uint64_t state;
+    uint32_t nonce;
+    int session_id;
+    int io_count;
+    uint8_t caps;
+    unsigned long wire_in;
+    unsigned long raw_in;
+    unsigned long wire_out;
+    unsigned long raw_out;
+    uint64_t expires_ms;
+    uint32_t out_len;
+    uint8_t out[SESSION_RESUME_OUTBUF];
+} SessionSlot;
+typedef struct 
+{
+    SessionSlot slots[SESSION_TABLE_SIZE];
+} SessionTable;
+typedef enum 
+{
+    PUBSUB_SUB_FREE = 0,
+    PUBSUB_SUB_CLAIMED,
+    PUBSUB_SUB_ACTIVE,
+    PUBSUB_SUB_CLOSING,
+    PUBSUB_SUB_REAPING
+} PubSubSubState;
+typedef struct 
+{
+    _Atomic uint64_t refcnt;
+    uint32_t len;
+    uint8_t data[PUBSUB_MSG_MAX];
+} PubSubMessage;
+typedef struct 
+{
+    _Atomic uint32_t state;
+    _Atomic pid_t lock;
+    pid_t pid;
+    int session_id;
+    uint32_t topic_hash;
+    uint32_t topic_len;
+    char topic[PUBSUB_TOPIC_MAX];
+    _Atomic uint32_t head;
+    _Atomic uint32_t tail;
+    _Atomic unsigned long dropped;
+    uint32_t inbox[PUBSUB_INBOX_SIZE];
+} PubSubSubscriber;
+typedef struct 
+{
+    pid_t owner;
+    _Atomic uint32_t next_msg;
+    _Atomic uint32_t high_water;
+    _Atomic unsigned long published;
+    _Atomic unsigned long delivered;
+    _Atomic unsigned long dropped;
+    PubSubMessage msgs[PUBSUB_POOL_SIZE];
+    PubSubSubscriber subs[PUBSUB_MAX_SUBSCRIBERS];
+} PubSubBus;
+typedef struct ArenaChunk ArenaChunk;
+struct ArenaChunk
+{
+    ArenaChunk *next;
+    size_t size;
+    size_t used;
+};
+typedef struct 
+{
+    ArenaChunk *head;
+    size_t reserved;
+    size_t used;
+    unsigned long allocs;
+} Arena;
+typedef struct 
+{
+    unsigned long samples;
+    uint32_t rtt_us;
+    uint32_t rttvar_us;
+    uint32_t rtt_min_us;
+    uint32_t rtt_max_us;
+    uint64_t rtt_sum_us;
+    uint32_t retrans;
+    uint32_t lost;
+    uint32_t cwnd;
+    uint32_t cwnd_min;
+    uint64_t delivery_rate;
+    uint64_t delivery_rate_max;
+    uint64_t bytes_acked;
+    double server_us_sum;
+} TcpTelemetry;
+typedef struct 
+{
+    _Atomic uint64_t sessions;
+    _Atomic uint64_t samples;
+    _Atomic uint64_t rtt_sum_us;
+    _Atomic uint64_t rtt_max_us;
+    _Atomic uint64_t retrans;
+    _Atomic uint64_t lost;
+    _Atomic uint64_t bytes_acked;
+    _Atomic uint64_t server_us_sum;
+    _Atomic uint64_t requests;
+    _Atomic uint64_t rtt_hist[TCP_RTT_BUCKETS];
+} TcpTelemetryTotals;
+typedef enum 
+{
+    COMMAND_ECHO = 0,
+    COMMAND_STATS,
+    COMMAND_UPPER,
+    COMMAND_SLEEP,
+    COMMAND_DISCARD,
+    COMMAND_SINK,
+    COMMAND_LOGLEVEL,
+    COMMAND_COUNT
+} CommandId;
+typedef struct 
+{
+    uint8_t type;
+    uint8_t flags;
+    uint32_t length;
+    const uint8_t *payload;
+} FrameHeader;
 typedef struct 
 {
     int sock;
+    Arena *arena;
     struct sockaddr_in addr;
     int session_id;
     SessionState state;
     int io_count;
     time_t start_time;
     time_t last_activity;
+    TimerNode idle_timer;
+    TimerNode write_timer;
+    TimerNode tcp_info_timer;
+    int tcp_info_due;
+    TcpTelemetry tcp;
+    const char *close_reason;
+    struct ssl_st *tls;
+    int framing_checked;
+    int framed;
+    unsigned long crc_errors;
+    uint8_t caps;
+    unsigned long wire_in;
+    unsigned long raw_in;
+    unsigned long wire_out;
+    unsigned long raw_out;
+    double compress_ms;
+    double decompress_ms;
+    uint64_t resume_token;
+    uint8_t reply_flags;
+    int pubsub_slot;
+    int doorbell;
+    unsigned long published;
+    unsigned long fanout;
+    unsigned long received;
+    unsigned long pubsub_dropped;
+    double fanout_ms;
+    unsigned long command_counts[COMMAND_COUNT];
+    unsigned long sunk_bytes;
+    size_t pending_len;
+    uint8_t pending[SESSION_RESUME_OUTBUF];
+    size_t in_len;
+    uint8_t inbuf[FRAME_BUF_SIZE + 1];
+    uint8_t outbuf[FRAME_BUF_SIZE];
+    uint8_t scratch[FRAME_MAX_PAYLOAD];
 } SessionDescriptor;
 typedef struct 
+{
+    int epfd;
+    int spinning;
+    int cpu;
+    uint64_t last_data_ms;
+    unsigned long spin_wakeups;
+    unsigned long epoll_wakeups;
+    unsigned long fallbacks;
+} BusyPoll;
+typedef enum 
+{
+    PROXY_POLICY_LEASTCONN = 0,
+    PROXY_POLICY_HASH
+} ProxyPolicy;
+typedef struct 
+{
+    struct sockaddr_in addr;
+    char name[32];
+    int healthy;
+    int fails;
+    int active;
+    unsigned long total;
+    int probe_fd;                                                               // 진행 중인 헬스체크 connect (-1: 없음)
+} ProxyBackend;
+typedef struct 
+{
+    uint32_t point;
+    int backend;
+} ProxyRingPoint;
+typedef struct 
+{
+    ProxyBackend backends[PROXY_MAX_BACKENDS];
+    int backend_count;
+    ProxyPolicy policy;
+    ProxyRingPoint ring[PROXY_MAX_BACKENDS * PROXY_VNODES];
+    int ring_size;
+    time_t last_health_check;
+    uint64_t probe_deadline_ms;                                                 // 프로브 시한 (0: 진행 중인 프로브 없음)
+} ProxyConfig;
+typedef struct 
+{
+    int from;
+    int to;
+    int pipe[2];
+    size_t buffered;
+    int eof;
+    int shut;
+    unsigned long bytes;
+} ProxyPipe;
+typedef enum 
+{
+    WORKER_STARTING = 0,
+    WORKER_IDLE,
+    WORKER_READING,
+    WORKER_WRITING,
+    WORKER_CLOSING,
+    WORKER_ACTIVITY_COUNT
+} WorkerActivity;
+typedef struct 
+{
+    _Alignas(64) _Atomic pid_t pid;
+    int session_id;
+    struct sockaddr_in addr;
+    uint64_t spawn_ms;
+    _Atomic uint64_t bytes_in;
+    _Atomic uint64_t bytes_out;
+    _Atomic uint64_t last_activity_ms;
+    _Atomic uint32_t io_count;
+    _Atomic uint8_t activity;
+    int8_t backend;
+} WorkerRecord;
+typedef enum 
+{
+    START_PATH_FORK = 0,
+    START_PATH_POOL,
+    START_PATHS
+} StartPath;
+typedef struct 
+{
+    _Atomic uint64_t count;
+    _Atomic uint64_t sum_us;
+    _Atomic uint64_t max_us;
+    _Atomic uint64_t hist[START_LATENCY_BUCKETS];
+} StartLatency;
+typedef struct 
+{
+    WorkerRecord records[MAX_WORKERS];
+    StartLatency start[START_PATHS];
+} WorkerRecordTable;
+typedef struct 
+{
+    pid_t pid;
+    int record;
+} WorkerIndexEntry;
+typedef struct 
+{
+    WorkerIndexEntry index[WORKER_INDEX_SIZE];
+    int free_records[MAX_WORKERS];
+    int free_count;
+    int count;
+    unsigned long lookups;
+    unsigned long probes;
+    WorkerRecordTable *table;
+} WorkerRegistry;
+typedef enum 
+{
+    CRASH_SEGV = 0,
+    CRASH_ABRT,
+    CRASH_BUS,
+    CRASH_FPE,
+    CRASH_OTHER,
+    CRASH_EXEC,
+    CRASH_KIND_COUNT
+} CrashKind;
+typedef struct 
+{
+    uint32_t ip;
+    int crashes;
+    int offenses;
+    time_t window_start;
+    time_t quarantine_until;
+} CrashIpEntry;
+typedef struct 
+{
+    _Atomic uint32_t seq;
+    pid_t pid;
+    int session_id;
+    int signo;
+    int code;
+    uint32_t nframes;
+    uint64_t fault_addr;
+    uint64_t load_bias;
+    uint64_t image_size;
+    uint64_t time_ms;
+    uint64_t frames[CRASH_RECORD_FRAMES];
+} CrashRecord;
+typedef struct 
+{
+    _Atomic uint32_t head;
+    CrashRecord records[CRASH_RING_SIZE];
+} CrashRing;
+typedef struct 
+{
+    uint64_t hash;
+    unsigned long count;
+    CrashRecord sample;
+} CrashStack;
+typedef struct 
+{
+    CrashIpEntry ips[CRASH_IP_TABLE_SIZE];
+    uint64_t recent[CRASH_STORM_THRESHOLD];
+    int recent_pos;
+    uint64_t last_crash_ms;
+    uint64_t backoff_until_ms;
+    int backoff_level;
+    unsigned long crashes;
+    unsigned long by_kind[CRASH_KIND_COUNT];
+    unsigned long quarantines;
+    unsigned long rejected;
+    unsigned long backoffs;
+    uint64_t backoff_total_ms;
+    uint32_t ring_tail;
+    unsigned long ring_lost;
+    CrashStack stacks[CRASH_STACKS_MAX];
+    int stack_count;
+} CrashGuard;
+typedef enum 
+{
+    POOL_SLOT_FREE = 0,
+    POOL_SLOT_IDLE,
+    POOL_SLOT_BUSY,
+    POOL_SLOT_RETIRING
+} PoolSlotState;
+typedef enum 
+{
+    POOL_RETIRE_SESSIONS = 0,
+    POOL_RETIRE_RSS,
+    POOL_RETIRE_AGE,
+    POOL_RETIRE_SURPLUS,
+    POOL_RETIRE_REASONS
+} PoolRetireReason;
+typedef struct 
+{
+    pid_t pid;
+    int channel;
+    int record;
+    PoolSlotState status;
+    int sessions;
+    long rss_kb;
+    time_t spawn_time;
+} PoolWorker;
+typedef struct 
+{
+    PoolWorker slots[POOL_SLOTS];
+    int size;
+    int live;
+    int standby;
+    int max_sessions;
+    long max_rss_kb;
+    int max_age;
+    unsigned long handoffs;
+    unsigned long fallbacks;
+    unsigned long spawns;
+    unsigned long refills;
+    unsigned long retired[POOL_RETIRE_REASONS];
+    long peak_rss_kb;
+} WorkerPool;
+typedef struct 
+{
+    int session_id;
+    struct sockaddr_in addr;
+    uint64_t accept_us;
+} PoolHandoff;
+typedef struct 
+{
+    int sessions;
+    long rss_kb;
+    long heap;
+} PoolReport;
+typedef struct 
 {
     int active_sessions;
     int total_sessions;
     long heap_usage;
+    long arena_live;
+    long arena_mapped;
     int open_fds;
     time_t start_time;
 } ResourceMonitor;
@@ -59,15 +735,40 @@ typedef struct
 {
     volatile sig_atomic_t running;
     volatile sig_atomic_t child_died;
+    volatile sig_atomic_t log_reload;
     int worker_count;
     int total_forks;
     int zombie_reaped;
     time_t start_time;
     pid_t parent_pid;
     int log_fd;
+    struct ssl_ctx_st *tls_ctx;
+    SessionTable *sessions;
+    PubSubBus *pubsub;
+    TcpTelemetryTotals *telemetry;
+    ProxyConfig *proxy;
+    WorkerRegistry *workers;
+    CrashGuard *crash_guard;
+    CrashRing *crash_ring;
+    WorkerPool *pool;
+    WorkerRecordTable *worker_table;
+    WorkerRecord *self_record;
+    uint64_t accept_us;
+    StartPath start_path;
+    int port;
+    int signal_fd;
+    sigset_t saved_sigmask;
 } ServerState;
+typedef long (*CommandHandler)(ServerState *state, SessionDescriptor *session, const uint8_t *args, size_t len, uint8_t *out, size_t cap, const uint8_t **reply);
+typedef struct 
+{
+    const char *name;
+    size_t name_len;
+    CommandId id;
+    CommandHandler handler;
+} CommandEntry;
 extern void             run_server(void);
-extern int              fork_and_exec_worker(int serv_sock, int clnt_sock, int session_id, struct sockaddr_in *clnt_addr, ServerState *state);
+extern int              fork_and_exec_worker(int serv_sock, int clnt_sock, int session_id, struct sockaddr_in *clnt_addr, uint64_t accept_us, ServerState *state);
 extern void             handle_child_died(ServerState *state);
 extern void             shutdown_workers(ServerState *state);
 extern void             final_cleanup(ServerState *state);
@@ -77,11 +778,132 @@ extern void             monitor_resources(ResourceMonitor *monitor);
 extern void             print_resource_status(ResourceMonitor *monitor);
 extern long             get_heap_usage(void);
 extern int              count_open_fds(void);
-extern void             log_message(ServerState *state, LogLevel level, const char* format, ...);
+extern Arena            *arena_create(void);
+extern void             *arena_alloc(Arena *arena, size_t size);
+extern void             *arena_calloc(Arena *arena, size_t size);
+extern void             arena_release(Arena *arena);
+extern size_t           arena_live_usage(void);
+extern size_t           arena_mapped_usage(void);
+extern void             log_emit(LogSite *site, ServerState *state, LogLevel level, const char* format, ...) __attribute__((format(printf, 4, 5)));
+extern const char       *log_parse_spec(const char *p, LogArgSpec *spec);
+extern void             log_report_suppressed(ServerState *state, int force);
+extern int              log_levels_apply(const char *spec);
+extern int              log_levels_reload(ServerState *state);
+extern size_t           log_levels_format(char *out, size_t cap);
+extern _Atomic uint8_t  *log_module_levels;
+#define log_enabled(level) \
+    ((int)(level) >= (int)LOG_MIN_LEVEL && (int)(level) >= atomic_load_explicit(&log_module_levels[LOG_MODULE], memory_order_relaxed))
+#define log_message(state, level, ...) \
+    do { if (log_enabled(level)) { static LogSite log_site_ = {.file = __FILE__, .line = __LINE__, .module = LOG_MODULE}; log_emit(&log_site_, (state), (level), __VA_ARGS__); } } while (0)
+#define log_message_limited(state, level, per_sec, ...) \
+    do { if (log_enabled(level)) { static LogSite log_site_ = {.file = __FILE__, .line = __LINE__, .module = LOG_MODULE, .limit = (per_sec)}; log_emit(&log_site_, (state), (level), __VA_ARGS__); } } while (0)
+#define log_message_sampled(state, level, every, ...) \
+    do { if (log_enabled(level)) { static LogSite log_site_ = {.file = __FILE__, .line = __LINE__, .module = LOG_MODULE, .sample = (every)}; log_emit(&log_site_, (state), (level), __VA_ARGS__); } } while (0)
 extern void             log_init(ServerState *state);
 extern void             log_close(ServerState *state);
+extern void             log_flush_crash(void);
 extern void             setup_signal_handlers(ServerState *state);
-extern void             setup_child_signal_handlers(ServerState *state);
+extern int              setup_signalfd(ServerState *state);
+extern void             close_signalfd(ServerState *state);
+extern int              signalfd_dispatch(ServerState *state);
+extern uint64_t         timer_wheel_clock_ms(void);
+extern uint64_t         timer_wheel_clock_us(void);
+extern void             timer_wheel_init(TimerWheel *wheel);
+extern void             timer_arm(TimerWheel *wheel, TimerNode *node, long timeout_ms, TimerCallback callback, void *arg);
+extern void             timer_cancel(TimerWheel *wheel, TimerNode *node);
+extern int              timer_is_armed(const TimerNode *node);
+extern int              timer_wheel_advance(TimerWheel *wheel);
+extern int              timer_wheel_next_timeout(const TimerWheel *wheel, int max_ms);
+extern int              tls_init(ServerState *state);
+extern void             tls_cleanup(ServerState *state);
+extern int              tls_session_accept(ServerState *state, SessionDescriptor *session, int timeout_ms);
+extern void             tls_session_close(SessionDescriptor *session);
+extern ssize_t          session_read(SessionDescriptor *session, void *buf, size_t len);
+extern ssize_t          session_write(SessionDescriptor *session, const void *buf, size_t len);
+extern int              session_pending(SessionDescriptor *session);
+extern void             crc32c_init(void);
+extern const char       *crc32c_impl_name(void);
+extern int              crc32c_select(const char *name);
+extern uint32_t         crc32c_update(uint32_t crc, const void *data, size_t len);
+extern uint32_t         crc32c(const void *data, size_t len);
+extern long             frame_parse(const uint8_t *buf, size_t len, FrameHeader *hdr);
+extern long             frame_build(uint8_t *out, size_t cap, uint8_t type, uint8_t flags, const void *payload, uint32_t len);
+extern int              session_table_create(ServerState *state);
+extern int              session_table_attach(ServerState *state);
+extern void             session_table_destroy(ServerState *state);
+extern uint64_t         session_table_issue(ServerState *state, SessionDescriptor *session);
+extern int              session_table_resume(ServerState *state, SessionDescriptor *session, uint64_t token);
+extern void             session_table_park(ServerState *state, SessionDescriptor *session);
+extern void             session_table_release(ServerState *state, SessionDescriptor *session);
+extern int              busy_poll_enabled(void);
+extern int              busy_poll_setup(SessionDescriptor *session, BusyPoll *busy);
+extern int              busy_poll_wait(ServerState *state, SessionDescriptor *session, BusyPoll *busy, TimerWheel *wheel);
+extern void             busy_poll_close(SessionDescriptor *session, BusyPoll *busy);
+extern int              pubsub_create(ServerState *state);
+extern int              pubsub_attach(ServerState *state);
+extern void             pubsub_destroy(ServerState *state);
+extern int              pubsub_subscribe(ServerState *state, SessionDescriptor *session, const uint8_t *topic, uint32_t len);
+extern void             pubsub_unsubscribe(ServerState *state, SessionDescriptor *session);
+extern void             pubsub_reap(ServerState *state, pid_t pid);
+extern long             pubsub_publish(ServerState *state, SessionDescriptor *session, const uint8_t *payload, uint32_t len);
+extern const PubSubMessage *pubsub_next(ServerState *state, SessionDescriptor *session, uint32_t *idx);
+extern void             pubsub_release(ServerState *state, uint32_t idx);
+extern int              tcp_telemetry_create(ServerState *state);
+extern int              tcp_telemetry_attach(ServerState *state);
+extern void             tcp_telemetry_destroy(ServerState *state);
+extern int              tcp_telemetry_interval_ms(void);
+extern int              tcp_telemetry_sample(SessionDescriptor *session);
+extern void             tcp_telemetry_close(ServerState *state, SessionDescriptor *session);
+extern void             tcp_telemetry_report(ServerState *state);
+extern const CommandEntry *command_lookup(const uint8_t *token, size_t len);
+extern long             command_dispatch(ServerState *state, SessionDescriptor *session, const uint8_t *input, size_t len, uint8_t *out, size_t cap, const uint8_t **reply);
+extern const char       *command_name(CommandId id);
+extern int              proxy_init(ServerState *state);
+extern void             proxy_cleanup(ServerState *state);
+extern int              proxy_pick_backend(ServerState *state, const struct sockaddr_in *clnt_addr);
+extern void             proxy_track_worker(ServerState *state, int backend);
+extern void             proxy_worker_exited(ServerState *state, int backend);
+extern void             proxy_health_check(ServerState *state);
+extern int              proxy_poll_fill(ServerState *state, struct pollfd *pfds, int max);
+extern void             proxy_health_handle(ServerState *state, const struct pollfd *pfds, int count);
+extern void             proxy_session_main(int client_sock, int session_id, const char *backend_spec, ServerState *state);
+extern int              worker_registry_create(ServerState *state);
+extern void             worker_registry_destroy(ServerState *state);
+extern int              worker_registry_attach(ServerState *state);
+extern void             worker_registry_detach(ServerState *state);
+extern int              worker_registry_reserve(ServerState *state, int session_id, const struct sockaddr_in *addr, int backend);
+extern void             worker_registry_cancel(ServerState *state, int record);
+extern void             worker_registry_commit(ServerState *state, int record, pid_t pid);
+extern WorkerRecord     *worker_registry_find(ServerState *state, pid_t pid);
+extern int              worker_registry_remove(ServerState *state, pid_t pid, WorkerRecord *out);
+extern void             worker_registry_account(ServerState *state, size_t bytes_in, size_t bytes_out);
+extern void             worker_registry_dump(ServerState *state, LogLevel level, int limit);
+extern int              worker_registry_signal(ServerState *state, int signo);
+extern void             worker_registry_activity(ServerState *state, WorkerActivity activity);
+extern const char       *worker_activity_name(WorkerActivity activity);
+extern void             worker_registry_session_start(ServerState *state, uint64_t accept_us, StartPath path);
+extern void             worker_registry_latency_report(ServerState *state);
+extern int              crash_guard_init(ServerState *state);
+extern void             crash_guard_destroy(ServerState *state);
+extern int              crash_guard_record(ServerState *state, const WorkerRecord *info, int status);
+extern int              crash_guard_admit(ServerState *state, const struct sockaddr_in *addr);
+extern long             crash_guard_backoff_ms(ServerState *state);
+extern void             crash_guard_report(ServerState *state);
+extern int              crash_ring_create(ServerState *state);
+extern int              crash_ring_attach(ServerState *state);
+extern void             crash_ring_destroy(ServerState *state);
+extern int              crash_ring_write(int signo, const siginfo_t *info, int session_id);
+extern void             crash_ring_drain(ServerState *state);
+extern void             crash_ring_report(ServerState *state);
+extern int              worker_pool_init(ServerState *state, int serv_sock);
+extern void             worker_pool_destroy(ServerState *state);
+extern int              worker_pool_dispatch(ServerState *state, int serv_sock, int clnt_sock, int session_id, const struct sockaddr_in *clnt_addr, uint64_t accept_us);
+extern int              worker_pool_poll_fill(ServerState *state, struct pollfd *pfds, int max);
+extern void             worker_pool_handle(ServerState *state, const struct pollfd *pfds, int count, int serv_sock);
+extern void             worker_pool_exited(ServerState *state, pid_t pid);
+extern void             worker_pool_maintain(ServerState *state, int serv_sock);
+extern void             worker_pool_report(ServerState *state);
+extern void             worker_pool_main(ServerState *state);
 extern void             test_segfault(void);
 extern void             test_abort(void);
 extern void             test_division_by_zero(void);
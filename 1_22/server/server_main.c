@@ -1,3 +1,4 @@
+#define LOG_MODULE LOG_MODULE_ACCEPT
 #include "server_function.h"
 #include <poll.h>
 #include <sys/socket.h>
@@ -5,7 +6,7 @@
 void 
 run_server(void)
 {
-    int serv_sock, clnt_sock, session_id = 0;                                           // 소켓 및 세션 ID 변수 선언
+    int serv_sock = -1, clnt_sock, session_id = 0;                                      // 소켓 및 세션 ID 변수 선언
     struct sockaddr_in serv_addr, clnt_addr;                                            // 서버/클라이언트 주소 구조체
     int option = 1;                                                                     // 소켓 옵션 설정을 위한 값
     ServerState state = {0};                                                            // 서버상태 초기화
@@ -13,52 +14,88 @@ run_server(void)
     state.start_time = time(NULL);                                                      // 서버 시작 시각 기록
     state.parent_pid = getpid();                                                        // crash_handler에서 부모 확인용
     state.log_fd = -1;                                                                  // 로그 파일 디스크립터 초기값 설정
+    state.signal_fd = -1;
+    state.port = getenv(PORT_ENV) ? atoi(getenv(PORT_ENV)) : PORT;                      // 같은 호스트에 여러 인스턴스(백엔드) 실행용
     setup_signal_handlers(&state);                                                      // 시그널 핸들러 및 g_state 연결
     log_init(&state);                                                                   // 로그 시스템 시작 및 파일 열기
+    if (tls_init(&state) == -1)                                                         // 인증서/티켓 키를 시작 시점에 검증
+    {
+        log_message(&state, LOG_ERROR, "run_server() : TLS 초기화 실패");
+        goto cleanup;
+    }
+    if (session_table_create(&state) == -1)                                             // 재개 토큰용 공유 세션 테이블
+        log_message(&state, LOG_WARNING, "run_server() : 세션 테이블 없이 실행 (재개 비활성)");
+    if (pubsub_create(&state) == -1)                                                    // 발행/구독용 공유 메시지 버퍼
+        log_message(&state, LOG_WARNING, "run_server() : pub/sub 비활성");
+    if (tcp_telemetry_create(&state) == -1)                                             // 워커 간 TCP_INFO 합계
+        log_message(&state, LOG_WARNING, "run_server() : TCP 텔레메트리 합계 비활성");
+    if (worker_registry_create(&state) == -1)                                           // PID → Worker 메타데이터 (회수/종료 순서/진단)
+    {
+        log_message(&state, LOG_ERROR, "run_server() : Worker 레지스트리 생성 실패");
+        goto cleanup;
+    }
+    if (proxy_init(&state) == -1)                                                       // ECHO_PROXY_BACKENDS가 있으면 L4 프록시 모드
+        goto cleanup;
     log_message(&state, LOG_INFO, "=== Multi-Process Echo Server 시작 ===");
-    log_message(&state, LOG_INFO, "Port: %d", PORT);
+    log_message(&state, LOG_INFO, "Port: %d", state.port);
     serv_sock = socket(PF_INET, SOCK_STREAM, 0);                                        // TCP 소켓 생성
     if (serv_sock == -1) 
     {
         log_message(&state, LOG_ERROR, "run_server() : socket() 생성 실패: %s", strerror(errno));
-        log_close(&state);
-        return;
+        goto cleanup;
     }
     if (setsockopt(serv_sock, SOL_SOCKET, SO_REUSEADDR, &option, sizeof(option)) == -1) // 종료 후 즉시 재시작 가능하게 설정
     {
         log_message(&state, LOG_ERROR, "run_server() : setsockopt(SO_REUSEADDR) 실패: %s", strerror(errno));
-        close(serv_sock);
-        log_close(&state);
-        return;
+        goto cleanup;
     }
     memset(&serv_addr, 0, sizeof(serv_addr));
     serv_addr.sin_family = AF_INET;                                                     // IPv4 주소 체계 설정
     serv_addr.sin_addr.s_addr = htonl(INADDR_ANY);                                      // 모든 인터페이스의 IP 허용
-    serv_addr.sin_port = htons(PORT);                                                   // 지정된 포트 번호 설정
+    serv_addr.sin_port = htons(state.port);                                                 // 지정된 포트 번호 설정
     if (bind(serv_sock, (struct sockaddr*)&serv_addr, sizeof(serv_addr)) == -1)         // 소켓에 IP와 포트 번호 할당
     {
         if (errno == EADDRINUSE || errno == EACCES)
             log_message(&state, LOG_ERROR, "run_server() : bind() 실패: 포트가 이미 사용 중");
         else
             log_message(&state, LOG_ERROR, "run_server() : bind() 실패: %s", strerror(errno));
-        close(serv_sock);
-        log_close(&state);
-        return;
+        goto cleanup;
     }
     if (listen(serv_sock, 128) == -1)                                                   // 연결 대기 큐 생성 및 대기 상태 진입
     {
         log_message(&state, LOG_ERROR, "run_server() : listen() 실패: %s", strerror(errno));
-        close(serv_sock);
-        log_close(&state);
-        return;
+        goto cleanup;
     }
     log_message(&state, LOG_INFO, "클라이언트 연결 대기 중");
-    struct pollfd pfd = {.fd = serv_sock, .events = POLLIN, .revents = 0};
+    if (crash_guard_init(&state) == -1)                                                 // 크래시 폭주 시 accept 백오프 / IP 격리
+        log_message(&state, LOG_WARNING, "run_server() : 크래시 감시 없이 실행");
+    if (crash_ring_create(&state) == -1)                                                // Worker 크래시 스택을 받는 공유 링
+        log_message(&state, LOG_WARNING, "run_server() : 크래시 기록 링 없이 실행 (stderr 백트레이스)");
+    setup_signalfd(&state);                                                             // SIGCHLD/SIGINT/SIGTERM/SIGUSR1을 poll 이벤트로 수신 (실패 시 핸들러)
+    if (worker_pool_init(&state, serv_sock) == -1)                                      // ECHO_WORKER_POOL=N이면 상주 Worker 풀 (한도 초과 시 교체)
+        log_message(&state, LOG_WARNING, "run_server() : Worker 풀 없이 실행");
+    struct pollfd pfds[2 + POOL_SLOTS + PROXY_MAX_BACKENDS] = {{.fd = serv_sock, .events = POLLIN}, {.fd = state.signal_fd, .events = POLLIN}};   // [2..] 풀 Worker 채널, 그 뒤 헬스체크 프로브
+    int timeout = state.proxy ? PROXY_HEALTH_INTERVAL * 1000 : -1;                     // 주기 작업이 없으면 이벤트가 올 때까지 대기
     while (state.running)                                                               // running값 확인(직접참조)
     {
         handle_child_died(&state);                                                      // 자식 프로세스(좀비) 종료 여부 확인
-        pfd.revents = 0;
-        int ret = poll(&pfd, 1, 1000);                                                  // 1초 동안 이벤트 대기
+        proxy_health_check(&state);                                                     // 프록시 모드: 주기적 백엔드 헬스체크 시작 / 시한 초과 정리 (블로킹 없음)
+        worker_pool_maintain(&state, serv_sock);                                        // 죽거나 교체된 풀 Worker 보충, 대기 Worker 비동기 재충전
+        log_report_suppressed(&state, 0);                                               // 제한/샘플링된 로그의 생략 건수 (호출 지점당 주기마다 한 줄)
+        if (state.log_reload)                                                           // SIGUSR1: log_levels.conf의 모듈별 레벨 적용 (재시작 없이)
+        {
+            state.log_reload = 0;
+            log_levels_reload(&state);
+        }
+        int pool_count = worker_pool_poll_fill(&state, pfds + 2, POOL_SLOTS);
+        int probe_count = proxy_poll_fill(&state, pfds + 2 + pool_count, PROXY_MAX_BACKENDS);
+        pfds[0].revents = pfds[1].revents = 0;
+        long backoff = crash_guard_backoff_ms(&state);                                 // 크래시 폭주 중에는 accept를 멈추고 백로그에 대기시킴
+        pfds[0].events = backoff > 0 ? 0 : POLLIN;
+        int wait_ms = backoff > 0 && (timeout == -1 || backoff < timeout) ? (int)backoff : timeout;
+        if (probe_count > 0 && (wait_ms == -1 || wait_ms > PROXY_CONNECT_TIMEOUT))     // 응답 없는 프로브도 시한에 맞춰 정리되게
+            wait_ms = PROXY_CONNECT_TIMEOUT;
+        int ret = poll(pfds, 2 + pool_count + probe_count, wait_ms);                                  // signalfd가 없으면 pfds[1].fd = -1 → 무시됨
         if (ret == -1) 
         {
             if (errno == EINTR)                                                         // 시그널 발생시 continue, state.running값 확인 후 진행
@@ -68,30 +105,49 @@ run_server(void)
         } 
         else if (ret == 0) 
             continue;
-        if (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) 
+        if (pfds[1].revents & POLLIN)                                                   // 시그널 먼저 처리: accept 전에 회수해 worker_count를 최신으로
         {
-            log_message(&state, LOG_ERROR, "run_server() : 서버 소켓 에러: 0x%x", pfd.revents);
+            signalfd_dispatch(&state);
+            handle_child_died(&state);
+            if (!state.running)
+                break;
+        }
+        worker_pool_handle(&state, pfds + 2, pool_count, serv_sock);                   // 세션 완료 보고 → 유휴 전환 / 한도 초과 시 교체
+        proxy_health_handle(&state, pfds + 2 + pool_count, probe_count);               // 끝난 헬스체크 connect 판정
+        if (pfds[0].revents == 0)
+            continue;
+        if (pfds[0].revents & (POLLERR | POLLHUP | POLLNVAL)) 
+        {
+            log_message(&state, LOG_ERROR, "run_server() : 서버 소켓 에러: 0x%x", pfds[0].revents);
             continue;
         } 
-        else if (pfd.revents & POLLIN) 
+        else if (pfds[0].revents & POLLIN) 
         {
             socklen_t addr_size = sizeof(clnt_addr);   
             clnt_sock = accept(serv_sock, (struct sockaddr*)&clnt_addr, &addr_size);    // 클라이언트와 실제 통신할 소켓 생성
+            uint64_t accept_us = timer_wheel_clock_us();                                // 세션 시작 지연 측정 기준 (→ 첫 에코)
             if (clnt_sock == -1) 
             {
                 if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)
                  {
-                    log_message(&state, LOG_DEBUG, "run_server() : accept() 재시도");
+                    log_message_limited(&state, LOG_DEBUG, LOG_ACCEPT_RETRY_PER_SEC, "run_server() : accept() 재시도");
                     continue;
                 }
                 log_message(&state, LOG_ERROR, "run_server() : accept() 실패: %s", strerror(errno));
                 continue;
             }
+            if (crash_guard_admit(&state, &clnt_addr) == -1)                           // 격리된 IP: fork 없이 즉시 종료
+            {
+                close(clnt_sock);
+                continue;
+            }
             session_id++;
             char client_ip[INET_ADDRSTRLEN];
             inet_ntop(AF_INET, &clnt_addr.sin_addr, client_ip, sizeof(client_ip));                  //client ip를 문자열로 바꿔 로그 출력
             log_message(&state, LOG_INFO, "새 연결 수락: %s:%d (Session #%d)", client_ip, ntohs(clnt_addr.sin_port), session_id);
-            if (fork_and_exec_worker(serv_sock, clnt_sock, session_id, &clnt_addr, &state) == -1)   //accept된 소켓을 fork,exec
+            if (worker_pool_dispatch(&state, serv_sock, clnt_sock, session_id, &clnt_addr, accept_us) == 0)   // 대기 Worker에 fd 전달, 없으면 fork
+                continue;
+            if (fork_and_exec_worker(serv_sock, clnt_sock, session_id, &clnt_addr, accept_us, &state) == -1)   //accept된 소켓을 fork,exec
             {
                 close(clnt_sock);
                 log_message(&state, LOG_ERROR, "run_server() : Worker 생성 실패 (Session #%d)", session_id);
@@ -99,7 +155,7 @@ run_server(void)
         } 
         else 
         {
-            log_message(&state, LOG_WARNING, "run_server() : 처리 안된 이벤트: 0x%x", pfd.revents);
+            log_message(&state, LOG_WARNING, "run_server() : 처리 안된 이벤트: 0x%x", pfds[0].revents);
             continue;
         }
     }
@@ -108,6 +164,25 @@ run_server(void)
         log_message(&state, LOG_ERROR, "run_server() : close(serv_sock) 실패: %s", strerror(errno));
     else
         log_message(&state, LOG_INFO, "서버 소켓 닫기 완료");
+    serv_sock = -1;
     final_cleanup(&state);                                                                          // 동적 할당 등 자원 최종 정리
+cleanup:                                                                                            // 시작 실패도 여기로: 각 정리 함수는 만들어지지 않은 자원이면 무시
+    if (serv_sock != -1)
+        close(serv_sock);
+    crash_guard_report(&state);
+    crash_ring_report(&state);                                                                      // 스택별 집계 + addr2line 심볼화
+    crash_ring_destroy(&state);
+    crash_guard_destroy(&state);
+    worker_pool_report(&state);
+    worker_pool_destroy(&state);
+    proxy_cleanup(&state);
+    worker_registry_latency_report(&state);                                                         // 경로별 accept → 첫 에코 분포
+    worker_registry_destroy(&state);
+    tcp_telemetry_report(&state);
+    tcp_telemetry_destroy(&state);
+    pubsub_destroy(&state);
+    session_table_destroy(&state);
+    tls_cleanup(&state);
+    close_signalfd(&state);
     log_close(&state);
 }
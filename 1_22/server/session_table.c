@@ -0,0 +1,181 @@
+#include "server_function.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/random.h>
+
+#define SESSION_SLOT_MASK (SESSION_TABLE_SIZE - 1)
+
+static uint64_t
+session_table_now_ms(void)
+{
+    return timer_wheel_clock_ms();                                              // 모든 프로세스가 같은 MONOTONIC 기준 사용
+}
+static uint32_t
+session_token_nonce(void)
+{
+    uint32_t nonce = 0;
+    while (nonce == 0)                                                          // 0은 "토큰 없음"으로 예약
+    {
+        if (getrandom(&nonce, sizeof(nonce), 0) != sizeof(nonce))
+            nonce = (uint32_t)(timer_wheel_clock_ms() * 2654435761u) ^ (uint32_t)getpid();
+    }
+    return nonce;
+}
+static SessionTable *
+session_table_map(ServerState *state, pid_t owner, int create)
+{
+    char name[64];
+    snprintf(name, sizeof(name), SESSION_TABLE_SHM_FMT, (int)owner);           // 부모 PID별: 같은 호스트의 다른 인스턴스 테이블을 덮어쓰지 않음
+    int fd = shm_open(name, create ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDWR, 0600);
+    if (fd == -1)
+    {
+        log_message(state, LOG_ERROR, "session_table_map() : shm_open(%s) 실패: %s", name, strerror(errno));
+        return NULL;
+    }
+    if (create && ftruncate(fd, sizeof(SessionTable)) == -1)
+    {
+        log_message(state, LOG_ERROR, "session_table_map() : ftruncate() 실패: %s", strerror(errno));
+        close(fd);
+        return NULL;
+    }
+    SessionTable *table = mmap(NULL, sizeof(SessionTable), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);                                                                  // 매핑은 fd를 닫아도 유지
+    if (table == MAP_FAILED)
+    {
+        log_message(state, LOG_ERROR, "session_table_map() : mmap() 실패: %s", strerror(errno));
+        return NULL;
+    }
+    return table;
+}
+int
+session_table_create(ServerState *state)
+{
+    state->sessions = session_table_map(state, getpid(), 1);                    // 부모: 생성 (ftruncate로 0 초기화)
+    if (state->sessions == NULL)
+        return -1;
+    log_message(state, LOG_INFO, "세션 테이블 생성: " SESSION_TABLE_SHM_FMT " (%d 슬롯, 재개 유효 %d초)", (int)getpid(), SESSION_TABLE_SIZE, SESSION_RESUME_WINDOW);
+    return 0;
+}
+int
+session_table_attach(ServerState *state)
+{
+    state->sessions = session_table_map(state, getppid(), 0);                   // 워커: 부모가 만든 테이블에 연결
+    return state->sessions ? 0 : -1;
+}
+void
+session_table_destroy(ServerState *state)
+{
+    if (state->sessions == NULL)
+        return;
+    munmap(state->sessions, sizeof(SessionTable));
+    state->sessions = NULL;
+    if (getpid() == state->parent_pid)
+    {
+        char name[64];
+        snprintf(name, sizeof(name), SESSION_TABLE_SHM_FMT, (int)getpid());
+        shm_unlink(name);
+    }
+}
+static int
+session_slot_reclaimable(SessionSlot *slot, uint64_t word, uint64_t now)
+{
+    uint32_t st = (uint32_t)word;
+    pid_t owner = (pid_t)(word >> 32);                                          // 상태와 소유자를 한 워드로: CAS 한 번에 함께 바뀜
+    if (st == SESSION_SLOT_EMPTY)
+        return 1;
+    if (st == SESSION_SLOT_PARKED && slot->expires_ms <= now)                  // 재개 유효 시간 지난 세션
+        return 1;
+    if (st == SESSION_SLOT_OWNED && kill(owner, 0) == -1 && errno == ESRCH)    // 소유 워커가 비정상 종료
+        return 1;
+    return 0;
+}
+uint64_t
+session_table_issue(ServerState *state, SessionDescriptor *session)
+{
+    SessionTable *table = state->sessions;
+    if (table == NULL)
+        return 0;
+    uint64_t now = session_table_now_ms();
+    uint32_t nonce = session_token_nonce();
+    uint32_t start = nonce & SESSION_SLOT_MASK;
+    for (uint32_t i = 0; i < SESSION_TABLE_PROBE_LIMIT; i++)                    // 빈 슬롯 탐색은 제한된 범위에서만
+    {
+        uint32_t idx = (start + i) & SESSION_SLOT_MASK;
+        SessionSlot *slot = &table->slots[idx];
+        uint64_t word = atomic_load_explicit(&slot->state, memory_order_acquire);
+        if (!session_slot_reclaimable(slot, word, now))
+            continue;
+        if (!atomic_compare_exchange_strong(&slot->state, &word, SESSION_SLOT_WORD(SESSION_SLOT_OWNED, getpid())))  // 다른 워커와 경쟁 시 CAS로 소유권 획득 (죽은 소유자 회수도 같은 워드 기준)
+            continue;
+        slot->nonce = nonce;
+        slot->session_id = session->session_id;
+        slot->out_len = 0;
+        session->resume_token = ((uint64_t)nonce << 32) | idx;                  // 토큰 하위 32비트 = 슬롯 번호 → 조회 O(1)
+        return session->resume_token;
+    }
+    log_message(state, LOG_WARNING, "session_table_issue() : [Session #%d] 빈 슬롯 없음, 재개 토큰 미발급", session->session_id);
+    return 0;
+}
+int
+session_table_resume(ServerState *state, SessionDescriptor *session, uint64_t token)
+{
+    SessionTable *table = state->sessions;
+    if (table == NULL || token == 0)
+        return -1;
+    uint32_t idx = (uint32_t)token & SESSION_SLOT_MASK;
+    uint32_t nonce = (uint32_t)(token >> 32);
+    SessionSlot *slot = &table->slots[idx];
+    uint64_t word = SESSION_SLOT_WORD(SESSION_SLOT_PARKED, 0);
+    if (slot->nonce != nonce || slot->expires_ms <= session_table_now_ms())
+        return -1;
+    if (!atomic_compare_exchange_strong(&slot->state, &word, SESSION_SLOT_WORD(SESSION_SLOT_OWNED, getpid())))  // 동시에 두 연결이 같은 토큰으로 재개하지 못하게
+        return -1;
+    if (slot->nonce != nonce)                                                   // CAS 직전에 슬롯이 재사용된 경우
+    {
+        atomic_store_explicit(&slot->state, SESSION_SLOT_WORD(SESSION_SLOT_PARKED, 0), memory_order_release);
+        return -1;
+    }
+    if (session->resume_token != 0 && session->resume_token != token)           // 이 연결에 먼저 발급된 토큰은 반납
+        session_table_release(state, session);
+    session->session_id = slot->session_id;
+    session->io_count = slot->io_count;
+    session->caps = slot->caps;
+    session->wire_in = slot->wire_in;
+    session->raw_in = slot->raw_in;
+    session->wire_out = slot->wire_out;
+    session->raw_out = slot->raw_out;
+    session->pending_len = slot->out_len;
+    memcpy(session->pending, slot->out, slot->out_len);                         // 끊기기 전 보내지 못한 출력
+    slot->nonce = session_token_nonce();                                        // 재사용 방지를 위해 토큰 갱신
+    session->resume_token = ((uint64_t)slot->nonce << 32) | idx;
+    return 0;
+}
+void
+session_table_park(ServerState *state, SessionDescriptor *session)
+{
+    SessionTable *table = state->sessions;
+    if (table == NULL || session->resume_token == 0)
+        return;
+    SessionSlot *slot = &table->slots[(uint32_t)session->resume_token & SESSION_SLOT_MASK];
+    slot->io_count = session->io_count;
+    slot->caps = session->caps;
+    slot->wire_in = session->wire_in;
+    slot->raw_in = session->raw_in;
+    slot->wire_out = session->wire_out;
+    slot->raw_out = session->raw_out;
+    slot->out_len = session->pending_len;
+    memcpy(slot->out, session->pending, session->pending_len);
+    slot->expires_ms = session_table_now_ms() + SESSION_RESUME_WINDOW * 1000ULL;
+    atomic_store_explicit(&slot->state, SESSION_SLOT_WORD(SESSION_SLOT_PARKED, 0), memory_order_release);  // 데이터 기록 후 공개
+}
+void
+session_table_release(ServerState *state, SessionDescriptor *session)
+{
+    SessionTable *table = state->sessions;
+    if (table == NULL || session->resume_token == 0)
+        return;
+    SessionSlot *slot = &table->slots[(uint32_t)session->resume_token & SESSION_SLOT_MASK];
+    slot->nonce = 0;
+    atomic_store_explicit(&slot->state, SESSION_SLOT_WORD(SESSION_SLOT_EMPTY, 0), memory_order_release);
+    session->resume_token = 0;
+}
@@ -1,4 +1,58 @@
+#define LOG_MODULE LOG_MODULE_SHUTDOWN
 #include "server_function.h"
+static void
+shutdown_flag_expired(TimerNode *timer, void *arg)
+{
+    (void)timer;
+    *(int *)arg = 1;                                                                                        // 데드라인/진행 보고 시점 표시
+}
+static long
+shutdown_grace_ms(ServerState *state)
+{
+    const char *env = getenv(SHUTDOWN_GRACE_ENV);                                                           // ECHO_SHUTDOWN_GRACE_MS: 기본 유예 시간 변경
+    long grace = env ? atol(env) : SHUTDOWN_GRACE_PERIOD * 1000L;
+    grace += (long)state->worker_count * SHUTDOWN_GRACE_PER_WORKER_US / 1000;                               // 세션이 많을수록 드레인에 시간이 더 걸림
+    return grace < SHUTDOWN_GRACE_MAX * 1000L ? grace : SHUTDOWN_GRACE_MAX * 1000L;
+}
+static void
+shutdown_wait(ServerState *state, int timeout_ms)
+{
+    if (state->signal_fd != -1)                                                                             // SIGCHLD가 올 때까지 블록 (바쁜 대기 없음)
+    {
+        struct pollfd pfd = {.fd = state->signal_fd, .events = POLLIN, .revents = 0};
+        if (poll(&pfd, 1, timeout_ms) > 0)
+            signalfd_dispatch(state);
+    }
+    else
+        poll(NULL, 0, timeout_ms);                                                                          // 핸들러 모드: SIGCHLD가 EINTR로 깨움
+    handle_child_died(state);
+}
+static int
+shutdown_drain(ServerState *state, TimerWheel *wheel, long deadline_ms, const char *stage)
+{
+    TimerNode deadline = {0}, progress = {0};
+    int expired = 0, report = 0;
+    int start_count = state->worker_count;
+    uint64_t start_ms = timer_wheel_clock_ms();
+    timer_arm(wheel, &deadline, deadline_ms, shutdown_flag_expired, &expired);
+    timer_arm(wheel, &progress, SHUTDOWN_PROGRESS_MS, shutdown_flag_expired, &report);
+    while (state->worker_count > 0 && !expired)
+    {
+        shutdown_wait(state, timer_wheel_next_timeout(wheel, SHUTDOWN_PROGRESS_MS));
+        timer_wheel_advance(wheel);
+        if (report && state->worker_count > 0)                                                              // 주기적 진행 상황 보고
+        {
+            report = 0;
+            log_message(state, LOG_INFO, "%s 드레인 진행: %d/%d개 종료, 남은 Worker %d개 (%.1f초 경과)",
+                        stage, start_count - state->worker_count, start_count, state->worker_count, (timer_wheel_clock_ms() - start_ms) / 1000.0);
+            timer_arm(wheel, &progress, SHUTDOWN_PROGRESS_MS, shutdown_flag_expired, &report);
+        }
+    }
+    timer_cancel(wheel, &deadline);
+    timer_cancel(wheel, &progress);
+    log_message(state, LOG_INFO, "%s 드레인 완료: %d개 종료, %.1f초 소요", stage, start_count - state->worker_count, (timer_wheel_clock_ms() - start_ms) / 1000.0);
+    return start_count - state->worker_count;
+}
 void 
 shutdown_workers(ServerState *state)
 {
@@ -7,32 +61,30 @@ shutdown_workers(ServerState *state)
     log_message(state, LOG_INFO, "총 실행 시간: %ld초", end_time - state->start_time);
     log_message(state, LOG_INFO, "성공한 fork: %d개", state->total_forks);
     log_message(state, LOG_INFO, "회수한 좀비: %d개", state->zombie_reaped);
-    int initial_count = state->worker_count;                                                                // 종료 전 워커 수 기록
-    if (initial_count > 0) 
+    handle_child_died(state);                                                                               // 이미 끝난 Worker 먼저 회수
+    if (state->worker_count == 0)
     {
-        log_message(state, LOG_INFO, "shutdown_workers() : Worker %d개에 SIGTERM 전송", initial_count);      // 자식들에게 종료 권고 신호 전송
-        if (kill(0, SIGTERM) == -1)                                                                         // 그룹 내 모든 자식 프로세스에 신호 전송
-            log_message(state, LOG_ERROR, "shutdown_workers() : kill(0, SIGTERM) 실패: %s", strerror(errno));
+        log_message(state, LOG_INFO, "모든 Worker 정상 종료 완료");
+        return;
     }
-    log_message(state, LOG_INFO, "Worker 정상 종료 대기 중 (최대 5초)...");
-    time_t wait_start = time(NULL);                                                                         // 대기 시작 시간 기록
-    while (time(NULL) - wait_start < 5)                                                                     // 최대 5초간 자식들의 자발적 종료 대기
+    int initial_count = state->worker_count;                                                                // 종료 전 워커 수 기록
+    long grace_ms = shutdown_grace_ms(state);
+    int sent = worker_registry_signal(state, SIGTERM);                                                      // 1단계: 레지스트리의 Worker에만 SIGTERM (부모 제외)
+    log_message(state, LOG_INFO, "shutdown_workers() : Worker %d개에 SIGTERM 전송, 정상 종료 대기 (최대 %.1f초)", sent, grace_ms / 1000.0);
+    TimerWheel wheel;
+    timer_wheel_init(&wheel);
+    int graceful_exits = shutdown_drain(state, &wheel, grace_ms, "SIGTERM");
+    if (state->worker_count == 0)
     {
-        handle_child_died(state);                                                                           // 종료된 자식 회수(waitpid)
-        if (state->worker_count == 0)                                                                       // 모두 종료되었으면 즉시 반환
-        {
-            log_message(state, LOG_INFO, "모든 Worker 정상 종료 완료");
-            return;
-        }
+        log_message(state, LOG_INFO, "모든 Worker 정상 종료 완료");
+        return;
     }
-    int graceful_exits = initial_count - state->worker_count;
     log_message(state, LOG_INFO, "정상 종료: %d개, 남은 Worker: %d개", graceful_exits, state->worker_count);
-    if (state->worker_count > 0)                                                                            // 5초 후에도 살아있는 워커가 있다면
-    {
-        log_message(state, LOG_WARNING, "shutdown_workers() : 남은 Worker %d개 강제 종료 (SIGKILL)", state->worker_count);
-        if (kill(0, SIGKILL) == -1)                                                                         // 강제 종료 신호 전송
-            log_message(state, LOG_ERROR, "shutdown_workers() : kill(0, SIGKILL) 실패: %s", strerror(errno));
-    }
+    log_message(state, LOG_WARNING, "shutdown_workers() : 남은 Worker %d개 강제 종료 (SIGKILL)", state->worker_count);
+    worker_registry_dump(state, LOG_WARNING, SHUTDOWN_DUMP_LIMIT);                                         // 어떤 세션이 끝나지 않았는지 기록
+    worker_registry_signal(state, SIGKILL);                                                                 // 2단계: 강제 종료 후 회수까지 대기
+    shutdown_drain(state, &wheel, SHUTDOWN_KILL_WAIT_MS, "SIGKILL");
+    log_message(state, LOG_INFO, "강제 종료 후 남은 Worker: %d개 (시작 %d개)", state->worker_count, initial_count);
 }
 void 
 final_cleanup(ServerState *state)
@@ -41,11 +93,15 @@ final_cleanup(ServerState *state)
     int final_count = 0;
     pid_t pid;
     int status;
+    WorkerRecord info;
     while ((pid = waitpid(-1, &status, WNOHANG)) > 0) 
     {
         final_count++;
+        int known = worker_registry_remove(state, pid, &info) == 0;
+        if (known)
+            state->worker_count--;
         if (WIFSIGNALED(status) && WTERMSIG(status) == SIGKILL)
-            log_message(state, LOG_DEBUG, "final_cleanup() : SIGKILL로 종료된 Worker 회수: PID %d", pid);
+            log_message(state, LOG_DEBUG, "final_cleanup() : SIGKILL로 종료된 Worker 회수: PID %d (Session #%d)", pid, known ? info.session_id : -1);
     }
     if (pid == -1 && errno != ECHILD)
         log_message(state, LOG_ERROR, "final_cleanup() : waitpid() 에러: %s", strerror(errno));
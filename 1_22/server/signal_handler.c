@@ -1,5 +1,7 @@
+#define LOG_MODULE LOG_MODULE_SHUTDOWN
 #include "server_function.h"
 #include <execinfo.h>
+#include <sys/signalfd.h>
 
 static ServerState *g_state = NULL;
 static void 
@@ -16,13 +18,20 @@ signal_handler(int signo)
         if (g_state)
             g_state->running = 0;
     }
+    else if (signo == SIGUSR1)                      // 로그 레벨 다시 읽기: 실제 읽기는 메인 루프에서
+    {
+        if (g_state)
+            g_state->log_reload = 1;
+    }
     errno = saved_errno;
 }
 static void 
-crash_handler(int sig)
+crash_handler(int sig, siginfo_t *info, void *context)
 {
+    (void)context;
     void *buffer[MAX_FRAMES];
     int nptrs;
+    log_flush_crash();                                                              // 링에 남은 로그를 먼저 기록 (크래시 직전 상황)
     if (g_state && getpid() == g_state->parent_pid)
     {
         const char msg[] = "\n!!! PARENT CRASH !!!\n=== Stack Trace ===\n";
@@ -31,6 +40,11 @@ crash_handler(int sig)
         backtrace_symbols_fd(buffer, nptrs, STDERR_FILENO);
         kill(0, SIGTERM);
     } 
+    else if (crash_ring_write(sig, info, g_state && g_state->self_record ? g_state->self_record->session_id : -1) == 0)
+    {
+        const char msg[] = "\n!!! WORKER CRASH !!! (크래시 기록 → 부모)\n";           // 스택은 공유 링에 바이너리로 기록
+        write(STDERR_FILENO, msg, sizeof(msg) - 1);
+    }
     else 
     {
         const char msg[] = "\n!!! WORKER CRASH !!!\n=== Stack Trace ===\n";
@@ -61,43 +75,84 @@ setup_signal_handlers(ServerState *state)
         log_message(state, LOG_ERROR, "setup_signal_handlers() : sigaction(SIGINT) 실패: %s", strerror(errno));
     if (sigaction(SIGTERM, &sa, NULL) == -1)
         log_message(state, LOG_ERROR, "setup_signal_handlers() : sigaction(SIGTERM) 실패: %s", strerror(errno));
+    struct sigaction sa_usr1 = sa;
+    if (getpid() != state->parent_pid)
+        sa_usr1.sa_handler = SIG_IGN;                                               // Worker: 레벨 변경은 부모가 공유 메모리로 반영, 무시 (기본 동작은 종료)
+    if (sigaction(SIGUSR1, &sa_usr1, NULL) == -1)
+        log_message(state, LOG_ERROR, "setup_signal_handlers() : sigaction(SIGUSR1) 실패: %s", strerror(errno));
     struct sigaction sa_crash;
-    sa_crash.sa_handler = crash_handler;
+    sa_crash.sa_sigaction = crash_handler;
     sigemptyset(&sa_crash.sa_mask);
-    sa_crash.sa_flags = SA_RESETHAND;
+    sa_crash.sa_flags = SA_RESETHAND | SA_SIGINFO;                                  // si_addr(폴트 주소) 수집
     if (sigaction(SIGSEGV, &sa_crash, NULL) == -1)
         log_message(state, LOG_ERROR, "setup_signal_handlers() : sigaction(SIGSEGV) 실패: %s", strerror(errno));
     if (sigaction(SIGABRT, &sa_crash, NULL) == -1)
         log_message(state, LOG_ERROR, "setup_signal_handlers() : sigaction(SIGABRT) 실패: %s", strerror(errno));
     if (sigaction(SIGBUS, &sa_crash, NULL) == -1)
         log_message(state, LOG_ERROR, "setup_signal_handlers() : sigaction(SIGBUS) 실패: %s", strerror(errno));
+    if (sigaction(SIGFPE, &sa_crash, NULL) == -1)
+        log_message(state, LOG_ERROR, "setup_signal_handlers() : sigaction(SIGFPE) 실패: %s", strerror(errno));
+}
+int
+setup_signalfd(ServerState *state)
+{
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGCHLD);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    sigaddset(&mask, SIGUSR1);
+    if (sigprocmask(SIG_BLOCK, &mask, &state->saved_sigmask) == -1)             // 핸들러 대신 signalfd로 받도록 차단
+    {
+        log_message(state, LOG_ERROR, "setup_signalfd() : sigprocmask() 실패: %s", strerror(errno));
+        return -1;
+    }
+    state->signal_fd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);          // 자식에게는 상속되지 않음
+    if (state->signal_fd == -1)
+    {
+        log_message(state, LOG_ERROR, "setup_signalfd() : signalfd() 실패: %s, 시그널 핸들러로 동작", strerror(errno));
+        sigprocmask(SIG_SETMASK, &state->saved_sigmask, NULL);
+        return -1;
+    }
+    return 0;
 }
 void
-setup_child_signal_handlers(ServerState *state)
+close_signalfd(ServerState *state)
 {
-    g_state = state;
-    struct sigaction sa_ignore;
-    sa_ignore.sa_handler = SIG_IGN;
-    sigemptyset(&sa_ignore.sa_mask);
-    sa_ignore.sa_flags = 0;
-    if (sigaction(SIGINT, &sa_ignore, NULL) == -1)
-        log_message(state, LOG_ERROR, "setup_child_signal_handlers() : sigaction(SIGINT) 무시 설정 실패: %s", strerror(errno));
-    if (sigaction(SIGPIPE, &sa_ignore, NULL) == -1)
-        log_message(state, LOG_ERROR, "setup_child_signal_handlers() : sigaction(SIGPIPE) 실패: %s", strerror(errno));
-    struct sigaction sa;
-    sa.sa_handler = signal_handler;
-    sigemptyset(&sa.sa_mask);
-    sa.sa_flags = 0;
-    if (sigaction(SIGTERM, &sa, NULL) == -1)
-        log_message(state, LOG_ERROR, "setup_child_signal_handlers() : sigaction(SIGTERM) 실패: %s", strerror(errno));
-    struct sigaction sa_crash;
-    sa_crash.sa_handler = crash_handler;
-    sigemptyset(&sa_crash.sa_mask);
-    sa_crash.sa_flags = SA_RESETHAND;
-    if (sigaction(SIGSEGV, &sa_crash, NULL) == -1)
-        log_message(state, LOG_ERROR, "setup_child_signal_handlers() : sigaction(SIGSEGV) 실패: %s", strerror(errno));
-    if (sigaction(SIGABRT, &sa_crash, NULL) == -1)
-        log_message(state, LOG_ERROR, "setup_child_signal_handlers() : sigaction(SIGABRT) 실패: %s", strerror(errno));
-    if (sigaction(SIGBUS, &sa_crash, NULL) == -1)
-        log_message(state, LOG_ERROR, "setup_child_signal_handlers() : sigaction(SIGBUS) 실패: %s", strerror(errno));
+    if (state->signal_fd == -1)
+        return;
+    close(state->signal_fd);
+    state->signal_fd = -1;
+    sigprocmask(SIG_SETMASK, &state->saved_sigmask, NULL);                      // 남은 시그널은 기존 핸들러로 전달
+}
+int
+signalfd_dispatch(ServerState *state)
+{
+    struct signalfd_siginfo info[16];
+    int handled = 0;
+    if (state->signal_fd == -1)
+        return 0;
+    for (;;)
+    {
+        ssize_t n = read(state->signal_fd, info, sizeof(info));
+        if (n <= 0)
+        {
+            if (n == -1 && errno != EAGAIN && errno != EINTR)
+                log_message(state, LOG_ERROR, "signalfd_dispatch() : read() 실패: %s", strerror(errno));
+            break;
+        }
+        for (size_t i = 0; i < (size_t)n / sizeof(info[0]); i++, handled++)
+        {
+            if (info[i].ssi_signo == SIGCHLD)                                   // 여러 SIGCHLD가 하나로 합쳐질 수 있으므로 waitpid 루프로 회수
+                state->child_died = 1;
+            else if (info[i].ssi_signo == SIGINT || info[i].ssi_signo == SIGTERM)
+            {
+                if ((pid_t)info[i].ssi_pid != getpid())                         // 자기 자신의 kill(0, ...)은 무시
+                    state->running = 0;
+            }
+            else if (info[i].ssi_signo == SIGUSR1)
+                state->log_reload = 1;
+        }
+    }
+    return handled;
 }
@@ -0,0 +1,164 @@
+#define LOG_MODULE LOG_MODULE_MONITOR
+#include "server_function.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <linux/tcp.h>
+
+static TcpTelemetryTotals *
+tcp_telemetry_map(ServerState *state, pid_t owner, int create)
+{
+    char name[64];
+    snprintf(name, sizeof(name), TCP_TELEMETRY_SHM_FMT, (int)owner);           // 부모 PID별: 인스턴스마다 따로 합산
+    int fd = shm_open(name, create ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDWR, 0600);
+    if (fd == -1)
+    {
+        log_message(state, LOG_ERROR, "tcp_telemetry_map() : shm_open(%s) 실패: %s", name, strerror(errno));
+        return NULL;
+    }
+    if (create && ftruncate(fd, sizeof(TcpTelemetryTotals)) == -1)
+    {
+        log_message(state, LOG_ERROR, "tcp_telemetry_map() : ftruncate() 실패: %s", strerror(errno));
+        close(fd);
+        return NULL;
+    }
+    TcpTelemetryTotals *totals = mmap(NULL, sizeof(TcpTelemetryTotals), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (totals == MAP_FAILED)
+    {
+        log_message(state, LOG_ERROR, "tcp_telemetry_map() : mmap() 실패: %s", strerror(errno));
+        return NULL;
+    }
+    return totals;
+}
+int
+tcp_telemetry_create(ServerState *state)
+{
+    state->telemetry = tcp_telemetry_map(state, getpid(), 1);                     // 부모: 워커 간 합계 영역 생성
+    return state->telemetry ? 0 : -1;
+}
+int
+tcp_telemetry_attach(ServerState *state)
+{
+    state->telemetry = tcp_telemetry_map(state, getppid(), 0);
+    return state->telemetry ? 0 : -1;
+}
+void
+tcp_telemetry_destroy(ServerState *state)
+{
+    if (state->telemetry == NULL)
+        return;
+    munmap(state->telemetry, sizeof(TcpTelemetryTotals));
+    state->telemetry = NULL;
+    if (getpid() == state->parent_pid)
+    {
+        char name[64];
+        snprintf(name, sizeof(name), TCP_TELEMETRY_SHM_FMT, (int)getpid());
+        shm_unlink(name);
+    }
+}
+int
+tcp_telemetry_interval_ms(void)
+{
+    const char *env = getenv(TCP_INFO_ENV);                                     // ECHO_TCP_INFO_MS=0이면 종료 시에만 샘플링
+    return env ? atoi(env) : TCP_INFO_INTERVAL_MS;
+}
+int
+tcp_telemetry_sample(SessionDescriptor *session)
+{
+    struct tcp_info info;
+    socklen_t len = sizeof(info);
+    memset(&info, 0, sizeof(info));                                             // 오래된 커널은 구조체 앞부분만 채움
+    if (getsockopt(session->sock, IPPROTO_TCP, TCP_INFO, &info, &len) == -1)
+        return -1;
+    TcpTelemetry *tcp = &session->tcp;
+    tcp->samples++;
+    tcp->rtt_us = info.tcpi_rtt;                                                // 커널의 smoothed RTT
+    tcp->rttvar_us = info.tcpi_rttvar;
+    tcp->rtt_sum_us += info.tcpi_rtt;
+    if (tcp->samples == 1 || info.tcpi_rtt < tcp->rtt_min_us)
+        tcp->rtt_min_us = info.tcpi_rtt;
+    if (info.tcpi_rtt > tcp->rtt_max_us)
+        tcp->rtt_max_us = info.tcpi_rtt;
+    tcp->retrans = info.tcpi_total_retrans;                                     // 누적값이므로 마지막 샘플이 곧 합계
+    tcp->lost = info.tcpi_lost;
+    tcp->cwnd = info.tcpi_snd_cwnd;
+    if (tcp->samples == 1 || info.tcpi_snd_cwnd < tcp->cwnd_min)
+        tcp->cwnd_min = info.tcpi_snd_cwnd;
+    tcp->delivery_rate = info.tcpi_delivery_rate;                               // bytes/s, 앱이 보낼 게 없으면 낮게 나옴
+    if (info.tcpi_delivery_rate > tcp->delivery_rate_max)
+        tcp->delivery_rate_max = info.tcpi_delivery_rate;
+    tcp->bytes_acked = info.tcpi_bytes_acked;
+    return 0;
+}
+static int
+tcp_telemetry_bucket(uint32_t rtt_us)
+{
+    int bucket = 0;
+    while (rtt_us > 1 && bucket < TCP_RTT_BUCKETS - 1)                          // log2(us) 구간
+    {
+        rtt_us >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+void
+tcp_telemetry_close(ServerState *state, SessionDescriptor *session)
+{
+    if (tcp_telemetry_sample(session) == -1)                                    // 닫기 직전 최종 샘플
+        return;
+    TcpTelemetry *tcp = &session->tcp;
+    double server_us = session->io_count > 0 ? tcp->server_us_sum / session->io_count : 0.0;
+    log_message(state, LOG_INFO, "[Session #%d] TCP: srtt %.2f ms (min %.2f / max %.2f, rttvar %.2f), retrans %u, lost %u, cwnd %u (min %u), "
+                "delivery %.2f Mbit/s (max %.2f), acked %llu bytes, 샘플 %lu | 서버 처리 평균 %.1f us",
+                session->session_id, tcp->rtt_us / 1000.0, tcp->rtt_min_us / 1000.0, tcp->rtt_max_us / 1000.0, tcp->rttvar_us / 1000.0,
+                tcp->retrans, tcp->lost, tcp->cwnd, tcp->cwnd_min,
+                tcp->delivery_rate * 8 / 1e6, tcp->delivery_rate_max * 8 / 1e6, (unsigned long long)tcp->bytes_acked, tcp->samples, server_us);
+    TcpTelemetryTotals *totals = state->telemetry;
+    if (totals == NULL)
+        return;
+    atomic_fetch_add(&totals->sessions, 1);                                     // 워커 간 합계 (부모가 종료 시 보고)
+    atomic_fetch_add(&totals->samples, tcp->samples);
+    atomic_fetch_add(&totals->rtt_sum_us, tcp->rtt_us);
+    atomic_fetch_add(&totals->retrans, tcp->retrans);
+    atomic_fetch_add(&totals->lost, tcp->lost);
+    atomic_fetch_add(&totals->bytes_acked, tcp->bytes_acked);
+    atomic_fetch_add(&totals->server_us_sum, (uint64_t)tcp->server_us_sum);
+    atomic_fetch_add(&totals->requests, (uint64_t)session->io_count);
+    atomic_fetch_add(&totals->rtt_hist[tcp_telemetry_bucket(tcp->rtt_us)], 1);
+    uint64_t max = atomic_load(&totals->rtt_max_us);
+    while (tcp->rtt_max_us > max && !atomic_compare_exchange_weak(&totals->rtt_max_us, &max, tcp->rtt_max_us))
+        ;
+}
+static uint64_t
+tcp_telemetry_percentile(const TcpTelemetryTotals *totals, uint64_t count, double p)
+{
+    uint64_t target = (uint64_t)(count * p), seen = 0;
+    for (int b = 0; b < TCP_RTT_BUCKETS; b++)
+    {
+        seen += atomic_load(&totals->rtt_hist[b]);
+        if (seen > target)
+            return 1ULL << (b + 1);                                             // 구간 상한 (2배 정밀도)
+    }
+    return 1ULL << TCP_RTT_BUCKETS;
+}
+void
+tcp_telemetry_report(ServerState *state)
+{
+    TcpTelemetryTotals *totals = state->telemetry;
+    if (totals == NULL)
+        return;
+    uint64_t sessions = atomic_load(&totals->sessions);
+    if (sessions == 0)
+        return;
+    uint64_t requests = atomic_load(&totals->requests);
+    log_message(state, LOG_INFO, "TCP 텔레메트리 합계: 세션 %llu개, 샘플 %llu, 세션 srtt 평균 %.2f ms (p50 < %.2f ms, p99 < %.2f ms, max %.2f ms), "
+                "retrans %llu, lost %llu, acked %llu bytes | 서버 처리 평균 %.1f us/요청",
+                (unsigned long long)sessions, (unsigned long long)atomic_load(&totals->samples),
+                atomic_load(&totals->rtt_sum_us) / 1000.0 / sessions,
+                tcp_telemetry_percentile(totals, sessions, 0.50) / 1000.0, tcp_telemetry_percentile(totals, sessions, 0.99) / 1000.0,
+                atomic_load(&totals->rtt_max_us) / 1000.0,
+                (unsigned long long)atomic_load(&totals->retrans), (unsigned long long)atomic_load(&totals->lost),
+                (unsigned long long)atomic_load(&totals->bytes_acked),
+                requests ? (double)atomic_load(&totals->server_us_sum) / requests : 0.0);
+}
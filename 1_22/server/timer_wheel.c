@@ -0,0 +1,178 @@
+#include "server_function.h"
+
+#define TW_SLOT_MASK (TW_SLOTS - 1)
+
+static void
+timer_list_init(TimerNode *head)
+{
+    head->next = head;
+    head->prev = head;
+}
+static void
+timer_list_add(TimerNode *head, TimerNode *node)
+{
+    node->prev = head->prev;                                                    // 슬롯 리스트 끝에 연결 (O(1))
+    node->next = head;
+    head->prev->next = node;
+    head->prev = node;
+}
+static void
+timer_list_unlink(TimerNode *node)
+{
+    node->prev->next = node->next;                                              // 양방향 리스트라 위치와 무관하게 O(1) 해제
+    node->next->prev = node->prev;
+    node->next = NULL;
+    node->prev = NULL;
+}
+static void
+timer_wheel_place(TimerWheel *wheel, TimerNode *node)
+{
+    uint64_t delta = node->expires - wheel->current_tick;
+    int level;
+    for (level = 0; level < TW_LEVELS - 1; level++)                             // 남은 tick 수에 맞는 레벨 선택
+    {
+        if (delta < ((uint64_t)1 << (TW_SLOT_BITS * (level + 1))))
+            break;
+    }
+    if (level == TW_LEVELS - 1 && delta >= ((uint64_t)1 << (TW_SLOT_BITS * TW_LEVELS)))
+    {
+        node->expires = wheel->current_tick + ((uint64_t)1 << (TW_SLOT_BITS * TW_LEVELS)) - 1;  // 최대 범위를 넘으면 끝 슬롯으로 제한
+    }
+    int idx = (int)((node->expires >> (TW_SLOT_BITS * level)) & TW_SLOT_MASK);
+    timer_list_add(&wheel->slots[level][idx], node);
+}
+uint64_t
+timer_wheel_clock_ms(void)
+{
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC_COARSE, &ts) == -1)                       // vDSO로 처리되는 저비용 시계 (해상도: jiffy)
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+uint64_t
+timer_wheel_clock_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);                                        // 지연 측정용: jiffy 해상도로는 부족
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+void
+timer_wheel_init(TimerWheel *wheel)
+{
+    for (int level = 0; level < TW_LEVELS; level++)
+    {
+        for (int i = 0; i < TW_SLOTS; i++)
+            timer_list_init(&wheel->slots[level][i]);
+    }
+    wheel->now_ms = timer_wheel_clock_ms();                                     // 캐시된 현재 시각
+    wheel->current_tick = wheel->now_ms / TIMER_TICK_MS + 1;
+    wheel->armed_count = 0;
+}
+void
+timer_arm(TimerWheel *wheel, TimerNode *node, long timeout_ms, TimerCallback callback, void *arg)
+{
+    if (node->next != NULL)                                                     // 이미 등록된 타이머는 먼저 해제
+        timer_cancel(wheel, node);
+    if (timeout_ms < 0)
+        timeout_ms = 0;
+    uint64_t ticks = ((uint64_t)timeout_ms + TIMER_TICK_MS - 1) / TIMER_TICK_MS;
+    if (ticks == 0)
+        ticks = 1;                                                              // 처리 중인 슬롯에 다시 들어가지 않도록 최소 1 tick
+    node->expires = wheel->now_ms / TIMER_TICK_MS + ticks;
+    if (node->expires < wheel->current_tick)
+        node->expires = wheel->current_tick;
+    node->callback = callback;
+    node->arg = arg;
+    timer_wheel_place(wheel, node);
+    wheel->armed_count++;
+}
+void
+timer_cancel(TimerWheel *wheel, TimerNode *node)
+{
+    if (node->next == NULL)                                                     // 등록되지 않은 타이머
+        return;
+    timer_list_unlink(node);
+    wheel->armed_count--;
+}
+int
+timer_is_armed(const TimerNode *node)
+{
+    return node->next != NULL;
+}
+static void
+timer_wheel_cascade(TimerWheel *wheel)
+{
+    for (int level = 1; level < TW_LEVELS; level++)                             // 상위 레벨 슬롯을 하위 레벨로 재배치
+    {
+        int idx = (int)((wheel->current_tick >> (TW_SLOT_BITS * level)) & TW_SLOT_MASK);
+        TimerNode *head = &wheel->slots[level][idx];
+        TimerNode pending;
+        timer_list_init(&pending);
+        if (head->next != head)                                                 // 슬롯 전체를 임시 리스트로 이동 후 재배치
+        {
+            pending.next = head->next;
+            pending.prev = head->prev;
+            pending.next->prev = &pending;
+            pending.prev->next = &pending;
+            timer_list_init(head);
+        }
+        while (pending.next != &pending)
+        {
+            TimerNode *node = pending.next;
+            timer_list_unlink(node);
+            timer_wheel_place(wheel, node);
+        }
+        if (idx != 0)                                                           // 이 레벨이 한 바퀴 돌지 않았으면 상위 레벨은 그대로
+            break;
+    }
+}
+int
+timer_wheel_advance(TimerWheel *wheel)
+{
+    int fired = 0;
+    wheel->now_ms = timer_wheel_clock_ms();
+    uint64_t target = wheel->now_ms / TIMER_TICK_MS;
+    if (wheel->armed_count == 0)                                                // 등록된 타이머가 없으면 tick만 맞춤
+    {
+        if (target >= wheel->current_tick)
+            wheel->current_tick = target + 1;
+        return 0;
+    }
+    while (wheel->current_tick <= target)                                       // current_tick = 아직 처리하지 않은 다음 tick
+    {
+        int idx = (int)(wheel->current_tick & TW_SLOT_MASK);
+        if (idx == 0)
+            timer_wheel_cascade(wheel);
+        TimerNode *head = &wheel->slots[0][idx];
+        while (head->next != head)                                              // 만료 슬롯의 타이머 실행 (콜백에서 재등록 가능)
+        {
+            TimerNode *node = head->next;
+            timer_list_unlink(node);
+            wheel->armed_count--;
+            fired++;
+            if (node->callback)
+                node->callback(node, node->arg);
+        }
+        wheel->current_tick++;
+    }
+    return fired;
+}
+int
+timer_wheel_next_timeout(const TimerWheel *wheel, int max_ms)
+{
+    if (wheel->armed_count == 0)
+        return max_ms;
+    for (int i = 0; i < TW_SLOTS; i++)                                          // 레벨 0만 최대 64칸 확인 (상수 시간)
+    {
+        uint64_t t = wheel->current_tick + (uint64_t)i;
+        const TimerNode *head = &wheel->slots[0][t & TW_SLOT_MASK];
+        if ((t & TW_SLOT_MASK) == 0 || head->next != head)                      // 만료 슬롯 또는 cascade 지점에서 깨어남
+        {
+            long ms = (long)(t * TIMER_TICK_MS) - (long)wheel->now_ms;
+            if (ms < 0)
+                return 0;
+            return ms < max_ms ? (int)ms : max_ms;
+        }
+    }
+    return max_ms;
+}
@@ -0,0 +1,270 @@
+#include "server_function.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#ifdef USE_TLS
+#include <openssl/ssl.h>
+#include <openssl/err.h>
+#include <openssl/rand.h>
+
+static void
+tls_log_errors(ServerState *state, const char *where)
+{
+    unsigned long err;
+    char errbuf[256];
+    while ((err = ERR_get_error()) != 0)                                        // OpenSSL 에러 큐 비우면서 기록
+    {
+        ERR_error_string_n(err, errbuf, sizeof(errbuf));
+        log_message(state, LOG_ERROR, "%s : %s", where, errbuf);
+    }
+}
+static int
+tls_load_ticket_key(ServerState *state, unsigned char *key, size_t key_len)
+{
+    char name[64];
+    int parent = getpid() == state->parent_pid;
+    snprintf(name, sizeof(name), TLS_TICKET_SHM_FMT, (int)(parent ? getpid() : getppid()));   // 모든 워커가 같은 티켓 키를 써야 재개(resumption) 가능
+    int fd = shm_open(name, parent ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDONLY, 0600);
+    if (fd == -1)
+    {
+        log_message(state, LOG_ERROR, "tls_load_ticket_key() : shm_open(%s) 실패: %s", name, strerror(errno));
+        return -1;
+    }
+    if (parent && ftruncate(fd, (off_t)key_len) == -1)
+    {
+        log_message(state, LOG_ERROR, "tls_load_ticket_key() : ftruncate() 실패: %s", strerror(errno));
+        close(fd);
+        shm_unlink(name);
+        return -1;
+    }
+    unsigned char *shared = mmap(NULL, key_len, parent ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (shared == MAP_FAILED)
+    {
+        log_message(state, LOG_ERROR, "tls_load_ticket_key() : mmap() 실패: %s", strerror(errno));
+        if (parent)
+            shm_unlink(name);
+        return -1;
+    }
+    if (parent && RAND_bytes(shared, (int)key_len) != 1)                        // 부모: 시작할 때마다 새 키 (디스크에 남기지 않음, 종료 시 삭제)
+    {
+        tls_log_errors(state, "tls_load_ticket_key() : RAND_bytes()");
+        munmap(shared, key_len);
+        shm_unlink(name);
+        return -1;
+    }
+    memcpy(key, shared, key_len);
+    munmap(shared, key_len);
+    if (parent)
+    {
+        if (unlink(TLS_TICKET_KEY_FILE) == 0)                                   // 이전 버전이 작업 디렉터리에 남긴 키 파일
+            log_message(state, LOG_WARNING, "tls_load_ticket_key() : 남아 있던 %s 삭제", TLS_TICKET_KEY_FILE);
+        log_message(state, LOG_INFO, "TLS 세션 티켓 키 생성: %s (메모리 전용, 재시작 시 교체)", name);
+    }
+    return 0;
+}
+int
+tls_init(ServerState *state)
+{
+    unsigned char ticket_key[TLS_TICKET_KEY_LEN];
+    SSL_CTX *ctx = SSL_CTX_new(TLS_server_method());
+    if (ctx == NULL)
+    {
+        tls_log_errors(state, "tls_init() : SSL_CTX_new()");
+        return -1;
+    }
+    SSL_CTX_set_min_proto_version(ctx, TLS1_2_VERSION);
+    SSL_CTX_set_options(ctx, SSL_OP_ENABLE_KTLS);                               // 핸드셰이크 후 레코드 계층을 커널(kTLS)로 내림
+    SSL_CTX_set_mode(ctx, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+    if (SSL_CTX_use_certificate_chain_file(ctx, TLS_CERT_FILE) != 1 ||
+        SSL_CTX_use_PrivateKey_file(ctx, TLS_KEY_FILE, SSL_FILETYPE_PEM) != 1 ||
+        SSL_CTX_check_private_key(ctx) != 1)
+    {
+        tls_log_errors(state, "tls_init() : 인증서/키 로드 실패");
+        SSL_CTX_free(ctx);
+        return -1;
+    }
+    if (tls_load_ticket_key(state, ticket_key, sizeof(ticket_key)) == -1)
+    {
+        SSL_CTX_free(ctx);
+        return -1;
+    }
+    SSL_CTX_set_tlsext_ticket_keys(ctx, ticket_key, sizeof(ticket_key));       // 상태 없는 티켓으로 워커 간 세션 재개
+    OPENSSL_cleanse(ticket_key, sizeof(ticket_key));
+    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_OFF);                    // 워커는 세션마다 새로 exec되므로 서버 캐시는 의미 없음
+    SSL_CTX_set_timeout(ctx, TLS_TICKET_LIFETIME);
+    state->tls_ctx = ctx;
+    log_message(state, LOG_INFO, "TLS 초기화 완료 (cert: %s, kTLS 요청)", TLS_CERT_FILE);
+    return 0;
+}
+void
+tls_cleanup(ServerState *state)
+{
+    if (state->tls_ctx == NULL)
+        return;
+    SSL_CTX_free(state->tls_ctx);
+    state->tls_ctx = NULL;
+    if (getpid() == state->parent_pid)
+    {
+        char name[64];
+        snprintf(name, sizeof(name), TLS_TICKET_SHM_FMT, (int)getpid());
+        shm_unlink(name);                                                       // 키는 이 실행 동안만 존재: 지난 티켓은 재시작 후 복호화 불가
+    }
+}
+int
+tls_session_accept(ServerState *state, SessionDescriptor *session, int timeout_ms)
+{
+    if (state->tls_ctx == NULL)
+        return 0;
+    SSL *ssl = SSL_new(state->tls_ctx);
+    if (ssl == NULL || SSL_set_fd(ssl, session->sock) != 1)
+    {
+        tls_log_errors(state, "tls_session_accept() : SSL_new()");
+        SSL_free(ssl);
+        return -1;
+    }
+    uint64_t deadline = timer_wheel_clock_ms() + (uint64_t)timeout_ms;
+    for (;;)                                                                    // 논블로킹 소켓에서 핸드셰이크 진행
+    {
+        int ret = SSL_accept(ssl);
+        if (ret == 1)
+            break;
+        int err = SSL_get_error(ssl, ret);
+        struct pollfd pfd = {.fd = session->sock, .events = 0, .revents = 0};
+        if (err == SSL_ERROR_WANT_READ)
+            pfd.events = POLLIN;
+        else if (err == SSL_ERROR_WANT_WRITE)
+            pfd.events = POLLOUT;
+        else
+        {
+            tls_log_errors(state, "tls_session_accept() : SSL_accept()");
+            SSL_free(ssl);
+            return -1;
+        }
+        uint64_t now = timer_wheel_clock_ms();
+        if (now >= deadline)
+        {
+            log_message(state, LOG_WARNING, "tls_session_accept() : [Session #%d] 핸드셰이크 타임아웃", session->session_id);
+            SSL_free(ssl);
+            return -1;
+        }
+        if (poll(&pfd, 1, (int)(deadline - now)) == -1 && errno != EINTR)
+        {
+            log_message(state, LOG_ERROR, "tls_session_accept() : poll() 실패: %s", strerror(errno));
+            SSL_free(ssl);
+            return -1;
+        }
+    }
+    session->tls = ssl;
+    log_message(state, LOG_INFO, "[Session #%d] TLS 핸드셰이크 완료: %s, %s, 재개=%s, kTLS tx=%s rx=%s",
+                session->session_id, SSL_get_version(ssl), SSL_get_cipher_name(ssl),
+                SSL_session_reused(ssl) ? "yes" : "no",
+                BIO_get_ktls_send(SSL_get_wbio(ssl)) ? "on" : "off",
+                BIO_get_ktls_recv(SSL_get_rbio(ssl)) ? "on" : "off");
+    return 0;
+}
+void
+tls_session_close(SessionDescriptor *session)
+{
+    if (session->tls == NULL)
+        return;
+    SSL_shutdown(session->tls);                                                 // close_notify 1회 전송 (응답은 기다리지 않음)
+    SSL_free(session->tls);
+    session->tls = NULL;
+}
+ssize_t
+session_read(SessionDescriptor *session, void *buf, size_t len)
+{
+    if (session->tls == NULL)
+        return read(session->sock, buf, len);
+    int ret = SSL_read(session->tls, buf, (int)len);                            // kTLS rx가 켜져 있으면 커널이 복호화
+    if (ret > 0)
+        return ret;
+    switch (SSL_get_error(session->tls, ret))
+    {
+        case SSL_ERROR_ZERO_RETURN:
+            return 0;
+        case SSL_ERROR_WANT_READ:
+        case SSL_ERROR_WANT_WRITE:
+            errno = EAGAIN;
+            return -1;
+        case SSL_ERROR_SYSCALL:
+            if (errno == 0)
+                return 0;
+            return -1;
+        default:
+            errno = EPROTO;
+            return -1;
+    }
+}
+ssize_t
+session_write(SessionDescriptor *session, const void *buf, size_t len)
+{
+    if (session->tls == NULL)
+        return write(session->sock, buf, len);
+    int ret = SSL_write(session->tls, buf, (int)len);                           // kTLS tx가 켜져 있으면 sendmsg 한 번으로 처리
+    if (ret > 0)
+        return ret;
+    switch (SSL_get_error(session->tls, ret))
+    {
+        case SSL_ERROR_WANT_READ:
+        case SSL_ERROR_WANT_WRITE:
+            errno = EAGAIN;
+            return -1;
+        case SSL_ERROR_SYSCALL:
+            if (errno == 0)
+                errno = EPIPE;
+            return -1;
+        default:
+            errno = EPROTO;
+            return -1;
+    }
+}
+int
+session_pending(SessionDescriptor *session)
+{
+    if (session->tls == NULL)
+        return 0;
+    return SSL_pending(session->tls);                                           // 이미 복호화되어 버퍼에 남은 데이터 (poll로는 보이지 않음)
+}
+#else
+int
+tls_init(ServerState *state)
+{
+    state->tls_ctx = NULL;                                                      // USE_TLS 없이 빌드: 평문 에코
+    return 0;
+}
+void
+tls_cleanup(ServerState *state)
+{
+    (void)state;
+}
+int
+tls_session_accept(ServerState *state, SessionDescriptor *session, int timeout_ms)
+{
+    (void)state;
+    (void)session;
+    (void)timeout_ms;
+    return 0;
+}
+void
+tls_session_close(SessionDescriptor *session)
+{
+    (void)session;
+}
+ssize_t
+session_read(SessionDescriptor *session, void *buf, size_t len)
+{
+    return read(session->sock, buf, len);
+}
+ssize_t
+session_write(SessionDescriptor *session, const void *buf, size_t len)
+{
+    return write(session->sock, buf, len);
+}
+int
+session_pending(SessionDescriptor *session)
+{
+    (void)session;
+    return 0;
+}
+#endif
@@ -1,3 +1,4 @@
+#define LOG_MODULE LOG_MODULE_WORKER
 #include "server_function.h"
 #include <limits.h>
 #include <sys/socket.h>
@@ -7,7 +8,9 @@ int main(int argc, char *argv[])
     int session_id;                                 // 세션 번호 저장 변수
     struct sockaddr_in client_addr;                 // 클라이언트 주소 정보
     socklen_t addr_len = sizeof(client_addr);       // 주소 구조체 크기
-    if (argc != 4)                                  // 인자 개수 확인 (세션ID, IP, 포트)
+    int status = 0;                                 // 종료 코드 (정리 경로는 cleanup 하나)
+    int pooled = (argc == 2 && strcmp(argv[1], "--pool") == 0);   // 풀 모드: fd 3은 부모와의 fd 전달 채널
+    if (argc != 4 && !pooled)                                  // 인자 개수 확인 (세션ID, IP, 포트)
     {
         fprintf(stderr, "main() : [Worker] 에러: 잘못된 인자 개수 (expected: 4, got: %d)\n", argc);
         fprintf(stderr, "main() : [Worker] 사용법: %s <session_id> <client_ip> <client_port>\n", argv[0]);
@@ -18,13 +21,35 @@ int main(int argc, char *argv[])
     state.log_fd = -1;                              // 로그 FD 초기화
     log_init(&state);                               // 워커 로그 시스템 초기화
     setup_signal_handlers(&state);                  // 워커용 시그널 핸들러 등록
+    if (tls_init(&state) == -1)                     // 부모가 만든 티켓 키로 TLS 컨텍스트 구성
+    {
+        fprintf(stderr, "main() : [Worker] TLS 초기화 실패\n");
+        status = EXIT_FAILURE;
+        goto cleanup;
+    }
+    if (session_table_attach(&state) == -1)         // 부모의 세션 테이블에 연결 (없으면 재개 없이 동작)
+        fprintf(stderr, "main() : [Worker] 세션 테이블 연결 실패, 재개 비활성\n");
+    if (pubsub_attach(&state) == -1)                // pub/sub 버스 연결 (없으면 구독/발행 거부)
+        fprintf(stderr, "main() : [Worker] pub/sub 버스 연결 실패\n");
+    if (tcp_telemetry_attach(&state) == -1)         // TCP_INFO 합계 영역 (없으면 세션 로그만)
+        fprintf(stderr, "main() : [Worker] TCP 텔레메트리 연결 실패\n");
+    if (worker_registry_attach(&state) == -1)       // 부모 레지스트리의 내 레코드 (없으면 바이트 집계 생략)
+        fprintf(stderr, "main() : [Worker] Worker 레지스트리 연결 실패\n");
+    if (crash_ring_attach(&state) == -1)            // 크래시 시 바이너리 기록 (없으면 stderr 백트레이스)
+        fprintf(stderr, "main() : [Worker] 크래시 기록 링 연결 실패\n");
+    if (pooled)                                     // 풀 모드: 부모가 보내는 세션을 교체될 때까지 반복 처리
+    {
+        worker_pool_main(&state);
+        goto cleanup;
+    }
     char *endptr;
     errno = 0;
     long sid_long = strtol(argv[1], &endptr, 10);   // 문자열 세션 ID를 숫자로 변환
     if (errno != 0 || *endptr != '\0' || sid_long < 0 || sid_long > INT_MAX) 
     {
         fprintf(stderr, "main() : [Worker] 에러: 잘못된 session_id 형식 '%s'\n", argv[1]);
-        return EXIT_FAILURE;
+        status = EXIT_FAILURE;
+        goto cleanup;
     }
     session_id = (int)sid_long;
     int client_sock = 3;                            // 부모가 dup2로 넘겨준 3번 FD 사용
@@ -33,16 +58,32 @@ int main(int argc, char *argv[])
     if (getsockopt(client_sock, SOL_SOCKET, SO_TYPE, &optval, &optlen) == -1)      // FD 3번이 실제 소켓인지 검증
     {
         fprintf(stderr, "main() : [Worker #%d] 에러: FD 3이 유효한 소켓이 아님: %s\n", session_id, strerror(errno));
-        return EXIT_FAILURE;
+        status = EXIT_FAILURE;
+        goto cleanup;
     }
     if (getpeername(client_sock, (struct sockaddr*)&client_addr, &addr_len) == -1) // 소켓을 통해 상대방 정보 획득
     {
         fprintf(stderr, "main() : [Worker #%d] 에러: getpeername() 실패: %s\n", session_id, strerror(errno));
-        return EXIT_FAILURE;
+        status = EXIT_FAILURE;
+        goto cleanup;
     }
     printf("[Worker #%d (PID:%d)] exec() 성공!\n", session_id, getpid());
-    child_process_main(client_sock, session_id, client_addr, &state);
+    const char *backend = getenv(PROXY_BACKEND_ENV);
+    const char *accepted = getenv(START_ACCEPT_ENV);
+    if (accepted != NULL)                           // 부모의 accept 시각 (fork+exec 경로 지연 측정)
+        worker_registry_session_start(&state, strtoull(accepted, NULL, 10), START_PATH_FORK);
+    if (backend != NULL)                            // 프록시 모드: 에코 대신 백엔드로 splice 전달
+        proxy_session_main(client_sock, session_id, backend, &state);
+    else
+        child_process_main(client_sock, session_id, client_addr, &state);
     printf("[Worker #%d (PID:%d)] 정상 종료\n", session_id, getpid());
+cleanup:                                            // 풀/단일 세션/실패 모두 같은 해제 순서
+    crash_ring_destroy(&state);
+    worker_registry_detach(&state);
+    tcp_telemetry_destroy(&state);
+    pubsub_destroy(&state);
+    session_table_destroy(&state);
+    tls_cleanup(&state);
     log_close(&state);                              // 로그 파일 닫기
-    return 0;                                       // 워커 프로세스 종료
+    return status;                                  // 워커 프로세스 종료
 }
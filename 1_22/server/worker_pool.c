@@ -0,0 +1,378 @@
+#define LOG_MODULE LOG_MODULE_WORKER
+#include "server_function.h"
+#include <fcntl.h>
+#include <sys/socket.h>
+
+static const char *const pool_retire_names[POOL_RETIRE_REASONS] = {"세션 수", "RSS", "수명", "대기 여유분"};
+
+static long
+pool_env_long(const char *name, long fallback)
+{
+    const char *env = getenv(name);
+    return env ? atol(env) : fallback;
+}
+static int
+worker_pool_spawn(ServerState *state, int serv_sock)
+{
+    WorkerPool *pool = state->pool;
+    PoolWorker *slot = NULL;
+    for (int i = 0; i < POOL_SLOTS && slot == NULL; i++)
+        if (pool->slots[i].status == POOL_SLOT_FREE)
+            slot = &pool->slots[i];
+    if (slot == NULL || state->worker_count >= MAX_WORKERS)
+        return -1;
+    int sv[2];
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sv) == -1)        // 메시지 경계 유지 + fd 전달 채널
+    {
+        log_message(state, LOG_ERROR, "worker_pool_spawn() : socketpair() 실패: %s", strerror(errno));
+        return -1;
+    }
+    struct sockaddr_in none = {0};
+    int record = worker_registry_reserve(state, -1, &none, -1);                 // 세션은 받을 때마다 레코드에 기록
+    if (record == -1)
+    {
+        close(sv[0]);
+        close(sv[1]);
+        return -1;
+    }
+    pid_t pid = fork();
+    if (pid == -1)
+    {
+        log_message(state, LOG_ERROR, "worker_pool_spawn() : fork() 실패: %s", strerror(errno));
+        worker_registry_cancel(state, record);
+        close(sv[0]);
+        close(sv[1]);
+        return -1;
+    }
+    else if (pid == 0)
+    {
+        close(serv_sock);
+        if (state->signal_fd != -1)
+            sigprocmask(SIG_SETMASK, &state->saved_sigmask, NULL);
+        if (dup2(sv[1], POOL_CHANNEL_FD) == -1)                                 // dup2는 CLOEXEC를 해제하므로 exec 후에도 유지
+            _exit(1);
+        char record_str[16];
+        snprintf(record_str, sizeof(record_str), "%d", record);
+        if (setenv(WORKER_SLOT_ENV, record_str, 1) == -1)
+            _exit(1);
+        char *const argv[] = {(char*)"./worker", (char*)"--pool", NULL};
+        execvp("./worker", argv);
+        fprintf(stderr, "worker_pool_spawn() : [풀 Worker] execvp() 실패: %s\n", strerror(errno));
+        _exit(127);
+    }
+    close(sv[1]);
+    memset(slot, 0, sizeof(*slot));
+    slot->pid = pid;
+    slot->channel = sv[0];
+    slot->record = record;
+    slot->status = POOL_SLOT_IDLE;                                              // exec 전이라도 전달한 fd는 채널 버퍼에서 대기
+    slot->spawn_time = time(NULL);
+    pool->live++;
+    pool->spawns++;
+    state->total_forks++;
+    state->worker_count++;
+    worker_registry_commit(state, record, pid);
+    log_message(state, LOG_DEBUG, "worker_pool_spawn() : 풀 Worker 생성 (PID: %d, 풀 %d/%d)", pid, pool->live, pool->size);
+    return 0;
+}
+static void
+worker_pool_retire(ServerState *state, PoolWorker *slot, PoolRetireReason reason, int serv_sock)
+{
+    WorkerPool *pool = state->pool;
+    pool->retired[reason]++;
+    pool->live--;
+    if (state->running && reason != POOL_RETIRE_SURPLUS)
+        worker_pool_spawn(state, serv_sock);                                    // 교체 Worker를 먼저 띄워 용량 공백 없음
+    log_message(state, LOG_INFO, "worker_pool_retire() : 풀 Worker PID %d 교체 (%s 한도: 세션 %d, RSS %ld KB, %ld초)",
+                slot->pid, pool_retire_names[reason], slot->sessions, slot->rss_kb, (long)(time(NULL) - slot->spawn_time));
+    close(slot->channel);                                                       // 채널 EOF → 진행 중 세션이 없으니 바로 종료
+    slot->channel = -1;
+    slot->status = POOL_SLOT_RETIRING;
+}
+static int
+worker_pool_check_limits(ServerState *state, PoolWorker *slot, int serv_sock)
+{
+    WorkerPool *pool = state->pool;
+    if (pool->max_sessions > 0 && slot->sessions >= pool->max_sessions)
+        worker_pool_retire(state, slot, POOL_RETIRE_SESSIONS, serv_sock);
+    else if (pool->max_rss_kb > 0 && slot->rss_kb > pool->max_rss_kb)
+        worker_pool_retire(state, slot, POOL_RETIRE_RSS, serv_sock);
+    else if (pool->max_age > 0 && time(NULL) - slot->spawn_time >= pool->max_age)
+        worker_pool_retire(state, slot, POOL_RETIRE_AGE, serv_sock);
+    else
+        return 0;
+    return 1;
+}
+int
+worker_pool_init(ServerState *state, int serv_sock)
+{
+    long size = pool_env_long(POOL_ENV, 0);                                     // ECHO_WORKER_POOL=N: 상주 Worker N개 (기본: 연결마다 fork)
+    long standby = pool_env_long(POOL_STANDBY_ENV, 0);                          // ECHO_WORKER_STANDBY=K: 유휴 Worker를 항상 K개 유지
+    if (size <= 0)
+        size = standby;
+    if (size <= 0)
+        return 0;
+    if (state->proxy)
+    {
+        log_message(state, LOG_WARNING, "worker_pool_init() : 프록시 모드에서는 Worker 풀 미사용");
+        return 0;
+    }
+    WorkerPool *pool = calloc(1, sizeof(WorkerPool));
+    if (pool == NULL)
+    {
+        log_message(state, LOG_ERROR, "worker_pool_init() : calloc() 실패");
+        return -1;
+    }
+    pool->size = size > POOL_MAX_WORKERS ? POOL_MAX_WORKERS : (int)size;
+    pool->standby = standby < 0 ? 0 : standby > POOL_MAX_WORKERS ? POOL_MAX_WORKERS : (int)standby;
+    pool->max_sessions = (int)pool_env_long(POOL_MAX_SESSIONS_ENV, POOL_MAX_SESSIONS);
+    pool->max_rss_kb = pool_env_long(POOL_MAX_RSS_ENV, POOL_MAX_RSS_KB);
+    pool->max_age = (int)pool_env_long(POOL_MAX_AGE_ENV, POOL_MAX_AGE);
+    for (int i = 0; i < POOL_SLOTS; i++)
+        pool->slots[i].channel = -1;
+    state->pool = pool;
+    for (int i = 0; i < pool->size; i++)
+        worker_pool_spawn(state, serv_sock);
+    log_message(state, LOG_INFO, "Worker 풀: %d개, 대기 목표 %d개 (교체 한도: 세션 %d, RSS %ld KB, 수명 %d초)",
+                pool->live, pool->standby, pool->max_sessions, pool->max_rss_kb, pool->max_age);
+    return 0;
+}
+void
+worker_pool_destroy(ServerState *state)
+{
+    WorkerPool *pool = state->pool;
+    if (pool == NULL)
+        return;
+    for (int i = 0; i < POOL_SLOTS; i++)
+        if (pool->slots[i].channel != -1)
+            close(pool->slots[i].channel);
+    free(pool);
+    state->pool = NULL;
+}
+static PoolWorker *
+worker_pool_pick(ServerState *state)
+{
+    WorkerPool *pool = state->pool;
+    PoolWorker *cold = NULL;
+    for (int i = 0; i < POOL_SLOTS; i++)
+    {
+        PoolWorker *slot = &pool->slots[i];
+        if (slot->status != POOL_SLOT_IDLE)
+            continue;
+        if (atomic_load_explicit(&state->workers->table->records[slot->record].activity, memory_order_relaxed) == WORKER_IDLE)
+            return slot;                                                        // 초기화를 마치고 recvmsg에서 대기 중
+        if (cold == NULL)
+            cold = slot;                                                        // 아직 exec/초기화 중: fd는 채널에서 대기
+    }
+    return cold;
+}
+static int
+worker_pool_idle(WorkerPool *pool)
+{
+    int idle = 0;
+    for (int i = 0; i < POOL_SLOTS; i++)
+        idle += pool->slots[i].status == POOL_SLOT_IDLE;
+    return idle;
+}
+int
+worker_pool_dispatch(ServerState *state, int serv_sock, int clnt_sock, int session_id, const struct sockaddr_in *clnt_addr, uint64_t accept_us)
+{
+    WorkerPool *pool = state->pool;
+    if (pool == NULL)
+        return -1;
+    PoolWorker *slot;
+    while ((slot = worker_pool_pick(state)) != NULL)
+    {
+        if (worker_pool_check_limits(state, slot, serv_sock))                   // 수명 초과는 유휴 상태에서 교체
+            continue;
+        PoolHandoff handoff = {.session_id = session_id, .addr = *clnt_addr, .accept_us = accept_us};
+        char control[CMSG_SPACE(sizeof(int))];
+        memset(control, 0, sizeof(control));
+        struct iovec iov = {.iov_base = &handoff, .iov_len = sizeof(handoff)};
+        struct msghdr msg = {.msg_iov = &iov, .msg_iovlen = 1, .msg_control = control, .msg_controllen = sizeof(control)};
+        struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;                                           // 클라이언트 소켓을 Worker에게 복제
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(cmsg), &clnt_sock, sizeof(int));
+        if (sendmsg(slot->channel, &msg, MSG_NOSIGNAL) == -1)
+        {
+            log_message(state, LOG_WARNING, "worker_pool_dispatch() : 풀 Worker PID %d 전달 실패: %s", slot->pid, strerror(errno));
+            close(slot->channel);                                               // 죽은 Worker: 회수는 SIGCHLD 경로에서
+            slot->channel = -1;
+            slot->status = POOL_SLOT_RETIRING;
+            pool->live--;
+            continue;
+        }
+        slot->status = POOL_SLOT_BUSY;                                          // 보충은 worker_pool_maintain()에서: accept 경로에 fork 없음
+        pool->handoffs++;
+        WorkerRecord *rec = &state->workers->table->records[slot->record];     // 진단/크래시 귀속용 현재 세션 정보
+        rec->session_id = session_id;
+        rec->addr = *clnt_addr;
+        close(clnt_sock);
+        log_message(state, LOG_INFO, "worker_pool_dispatch() : Session #%d → 풀 Worker PID %d", session_id, slot->pid);
+        return 0;
+    }
+    pool->fallbacks++;                                                          // 유휴 Worker 없음: 기존 fork 경로로 처리
+    return -1;
+}
+int
+worker_pool_poll_fill(ServerState *state, struct pollfd *pfds, int max)
+{
+    WorkerPool *pool = state->pool;
+    int n = 0;
+    if (pool == NULL)
+        return 0;
+    for (int i = 0; i < POOL_SLOTS && n < max; i++)
+    {
+        if (pool->slots[i].channel == -1)
+            continue;
+        pfds[n].fd = pool->slots[i].channel;
+        pfds[n].events = POLLIN;
+        pfds[n].revents = 0;
+        n++;
+    }
+    return n;
+}
+void
+worker_pool_handle(ServerState *state, const struct pollfd *pfds, int count, int serv_sock)
+{
+    WorkerPool *pool = state->pool;
+    if (pool == NULL)
+        return;
+    for (int n = 0; n < count; n++)
+    {
+        if (pfds[n].revents == 0)
+            continue;
+        PoolWorker *slot = NULL;
+        for (int i = 0; i < POOL_SLOTS && slot == NULL; i++)
+            if (pool->slots[i].channel == pfds[n].fd)
+                slot = &pool->slots[i];
+        if (slot == NULL)
+            continue;
+        PoolReport report;
+        ssize_t len = recv(slot->channel, &report, sizeof(report), MSG_DONTWAIT);
+        if (len == -1 && (errno == EAGAIN || errno == EINTR))
+            continue;
+        if (len != (ssize_t)sizeof(report))                                     // EOF/에러: Worker 비정상 종료
+        {
+            close(slot->channel);
+            slot->channel = -1;
+            if (slot->status != POOL_SLOT_RETIRING)
+                pool->live--;
+            slot->status = POOL_SLOT_RETIRING;
+            continue;
+        }
+        slot->status = POOL_SLOT_IDLE;                                          // 세션 완료 보고
+        slot->sessions = report.sessions;
+        slot->rss_kb = report.rss_kb;
+        if (report.rss_kb > pool->peak_rss_kb)
+            pool->peak_rss_kb = report.rss_kb;
+        if (worker_pool_check_limits(state, slot, serv_sock))
+            continue;
+        int spare_max = pool->standby * 2 > pool->size ? pool->standby * 2 : pool->size;
+        if (pool->standby > 0 && pool->live > pool->size && worker_pool_idle(pool) > spare_max)
+            worker_pool_retire(state, slot, POOL_RETIRE_SURPLUS, serv_sock);    // 몰림이 끝나면 축소 (여유 구간을 둬 생성/교체 반복 방지)
+    }
+}
+void
+worker_pool_exited(ServerState *state, pid_t pid)
+{
+    WorkerPool *pool = state->pool;
+    if (pool == NULL)
+        return;
+    for (int i = 0; i < POOL_SLOTS; i++)
+    {
+        PoolWorker *slot = &pool->slots[i];
+        if (slot->status == POOL_SLOT_FREE || slot->pid != pid)
+            continue;
+        if (slot->channel != -1)
+        {
+            close(slot->channel);
+            slot->channel = -1;
+        }
+        if (slot->status != POOL_SLOT_RETIRING)
+            pool->live--;
+        slot->status = POOL_SLOT_FREE;
+        return;
+    }
+}
+void
+worker_pool_maintain(ServerState *state, int serv_sock)
+{
+    WorkerPool *pool = state->pool;
+    if (pool == NULL || !state->running || crash_guard_backoff_ms(state) > 0)   // 크래시 폭주 중에는 보충하지 않음
+        return;
+    while (pool->live < pool->size && worker_pool_spawn(state, serv_sock) == 0)
+        ;
+    if (pool->standby == 0)
+        return;
+    int idle = worker_pool_idle(pool);
+    struct pollfd pending = {.fd = serv_sock, .events = POLLIN};
+    while (idle < pool->standby && pool->live < POOL_MAX_WORKERS)
+    {
+        if (idle > 0 && poll(&pending, 1, 0) > 0)                               // 대기 중인 연결이 있으면 accept 먼저, 보충은 다음 루프
+            break;
+        if (worker_pool_spawn(state, serv_sock) == -1)
+            break;
+        pool->refills++;
+        idle++;
+    }
+}
+void
+worker_pool_report(ServerState *state)
+{
+    WorkerPool *pool = state->pool;
+    if (pool == NULL)
+        return;
+    log_message(state, LOG_INFO, "Worker 풀: 전달 %lu건, fork 폴백 %lu건, 생성 %lu회 (대기 보충 %lu), 교체 (세션 %lu / RSS %lu / 수명 %lu / 여유분 %lu), 최대 RSS %ld KB",
+                pool->handoffs, pool->fallbacks, pool->spawns, pool->refills,
+                pool->retired[POOL_RETIRE_SESSIONS], pool->retired[POOL_RETIRE_RSS], pool->retired[POOL_RETIRE_AGE],
+                pool->retired[POOL_RETIRE_SURPLUS], pool->peak_rss_kb);
+}
+static long
+pool_rss_kb(void)
+{
+    long pages = 0, resident = 0;
+    FILE *fp = fopen("/proc/self/statm", "r");
+    if (fp == NULL)
+        return -1;
+    if (fscanf(fp, "%ld %ld", &pages, &resident) != 2)
+        resident = -1;
+    fclose(fp);
+    return resident < 0 ? -1 : resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+void
+worker_pool_main(ServerState *state)
+{
+    int sessions = 0;
+    printf("[풀 Worker (PID:%d)] 세션 대기\n", getpid());
+    while (state->running)
+    {
+        worker_registry_activity(state, WORKER_IDLE);                           // 세션 전달 대기
+        PoolHandoff handoff;
+        char control[CMSG_SPACE(sizeof(int))];
+        struct iovec iov = {.iov_base = &handoff, .iov_len = sizeof(handoff)};
+        struct msghdr msg = {.msg_iov = &iov, .msg_iovlen = 1, .msg_control = control, .msg_controllen = sizeof(control)};
+        ssize_t len = recvmsg(POOL_CHANNEL_FD, &msg, 0);                        // SIGTERM이면 EINTR로 깨어남
+        if (len == -1 && errno == EINTR)
+            continue;
+        if (len <= 0)                                                           // 부모가 채널을 닫음: 교체 요청
+            break;
+        struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+        if (len != (ssize_t)sizeof(handoff) || cmsg == NULL || cmsg->cmsg_type != SCM_RIGHTS)
+        {
+            fprintf(stderr, "worker_pool_main() : [풀 Worker] 잘못된 전달 메시지\n");
+            continue;
+        }
+        int client_sock;
+        memcpy(&client_sock, CMSG_DATA(cmsg), sizeof(int));
+        worker_registry_session_start(state, handoff.accept_us, START_PATH_POOL);
+        child_process_main(client_sock, handoff.session_id, handoff.addr, state);   // 세션 종료 시 소켓/아레나 정리됨
+        sessions++;
+        PoolReport report = {.sessions = sessions, .rss_kb = pool_rss_kb(), .heap = get_heap_usage()};
+        if (send(POOL_CHANNEL_FD, &report, sizeof(report), MSG_NOSIGNAL) == -1)
+            break;
+    }
+    printf("[풀 Worker (PID:%d)] 종료 - 세션 %d개 처리, RSS %ld KB\n", getpid(), sessions, pool_rss_kb());
+}
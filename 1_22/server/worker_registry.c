@@ -0,0 +1,328 @@
+#define LOG_MODULE LOG_MODULE_WORKER
+#include "server_function.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+
+#define WORKER_INDEX_MASK (WORKER_INDEX_SIZE - 1)
+
+_Static_assert(sizeof(WorkerRecord) == 64, "WorkerRecord는 캐시 라인 1개");            // 워커끼리 false sharing 없음
+
+static const char *const worker_activity_names[WORKER_ACTIVITY_COUNT] = {"STARTING", "IDLE", "READING", "WRITING", "CLOSING"};
+
+static uint32_t
+worker_index_home(pid_t pid)
+{
+    return ((uint32_t)pid * 2654435761u) >> (32 - WORKER_INDEX_BITS);          // 곱셈 해시: 연속된 PID도 고르게 분산
+}
+static WorkerRecordTable *
+worker_registry_map(ServerState *state, pid_t owner, int create)
+{
+    char name[64];
+    snprintf(name, sizeof(name), WORKER_REGISTRY_SHM_FMT, (int)owner);          // 부모 PID별 이름: 같은 호스트의 여러 인스턴스 분리
+    int fd = shm_open(name, create ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDWR, 0600);
+    if (fd == -1)
+    {
+        log_message(state, LOG_ERROR, "worker_registry_map() : shm_open(%s) 실패: %s", name, strerror(errno));
+        return NULL;
+    }
+    if (create && ftruncate(fd, sizeof(WorkerRecordTable)) == -1)
+    {
+        log_message(state, LOG_ERROR, "worker_registry_map() : ftruncate() 실패: %s", strerror(errno));
+        close(fd);
+        return NULL;
+    }
+    WorkerRecordTable *table = mmap(NULL, sizeof(WorkerRecordTable), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (table == MAP_FAILED)
+    {
+        log_message(state, LOG_ERROR, "worker_registry_map() : mmap() 실패: %s", strerror(errno));
+        return NULL;
+    }
+    return table;
+}
+int
+worker_registry_create(ServerState *state)
+{
+    WorkerRegistry *reg = calloc(1, sizeof(WorkerRegistry));                    // 인덱스는 부모 전용, 레코드는 공유 메모리
+    if (reg == NULL)
+    {
+        log_message(state, LOG_ERROR, "worker_registry_create() : calloc() 실패");
+        return -1;
+    }
+    reg->table = worker_registry_map(state, getpid(), 1);
+    if (reg->table == NULL)
+    {
+        free(reg);
+        return -1;
+    }
+    for (int i = MAX_WORKERS - 1; i >= 0; i--)                                  // 레코드 free list (낮은 번호부터 사용)
+        reg->free_records[reg->free_count++] = i;
+    state->workers = reg;
+    return 0;
+}
+void
+worker_registry_destroy(ServerState *state)
+{
+    WorkerRegistry *reg = state->workers;
+    if (reg == NULL)
+        return;
+    if (reg->lookups > 0)
+        log_message(state, LOG_INFO, "Worker 레지스트리: 조회 %lu회, 평균 탐사 %.2f칸", reg->lookups, (double)reg->probes / reg->lookups);
+    char name[64];
+    snprintf(name, sizeof(name), WORKER_REGISTRY_SHM_FMT, (int)getpid());
+    munmap(reg->table, sizeof(WorkerRecordTable));
+    shm_unlink(name);
+    free(reg);
+    state->workers = NULL;
+}
+int
+worker_registry_attach(ServerState *state)
+{
+    const char *slot = getenv(WORKER_SLOT_ENV);                                 // 부모가 exec 전에 넘겨준 내 레코드 번호
+    int record = slot ? atoi(slot) : -1;
+    if (record < 0 || record >= MAX_WORKERS)
+        return -1;
+    WorkerRecordTable *table = worker_registry_map(state, getppid(), 0);     // exec된 Worker의 부모 = 서버
+    if (table == NULL)
+        return -1;
+    state->worker_table = table;
+    state->self_record = &table->records[record];
+    return 0;
+}
+void
+worker_registry_detach(ServerState *state)
+{
+    if (state->worker_table == NULL)
+        return;
+    munmap(state->worker_table, sizeof(WorkerRecordTable));                     // 워커: 매핑만 해제 (unlink는 부모 몫)
+    state->worker_table = NULL;
+    state->self_record = NULL;
+}
+int
+worker_registry_reserve(ServerState *state, int session_id, const struct sockaddr_in *addr, int backend)
+{
+    WorkerRegistry *reg = state->workers;
+    if (reg->free_count == 0)
+        return -1;
+    int record = reg->free_records[--reg->free_count];
+    WorkerRecord *rec = &reg->table->records[record];                            // fork 전에 메타데이터를 채워 자식이 바로 사용 가능
+    atomic_store(&rec->pid, 0);
+    rec->session_id = session_id;
+    rec->addr = *addr;
+    rec->spawn_ms = timer_wheel_clock_ms();
+    rec->backend = (int8_t)backend;
+    atomic_store(&rec->activity, WORKER_STARTING);
+    atomic_store(&rec->last_activity_ms, rec->spawn_ms);
+    atomic_store(&rec->bytes_in, 0);
+    atomic_store(&rec->bytes_out, 0);
+    atomic_store(&rec->io_count, 0);
+    return record;
+}
+void
+worker_registry_cancel(ServerState *state, int record)
+{
+    state->workers->free_records[state->workers->free_count++] = record;        // fork 실패: 레코드 반납
+}
+void
+worker_registry_commit(ServerState *state, int record, pid_t pid)
+{
+    WorkerRegistry *reg = state->workers;
+    uint32_t i = worker_index_home(pid);
+    while (reg->index[i].pid != 0)                                              // 선형 탐사 (부하율 <= MAX_WORKERS / WORKER_INDEX_SIZE)
+        i = (i + 1) & WORKER_INDEX_MASK;
+    reg->index[i].pid = pid;
+    reg->index[i].record = record;
+    atomic_store(&reg->table->records[record].pid, pid);
+    reg->count++;
+}
+static int
+worker_index_find(WorkerRegistry *reg, pid_t pid)
+{
+    uint32_t i = worker_index_home(pid);
+    reg->lookups++;
+    for (int n = 0; n < WORKER_INDEX_SIZE; n++)
+    {
+        reg->probes++;
+        if (reg->index[i].pid == pid)
+            return (int)i;
+        if (reg->index[i].pid == 0)                                             // 빈 칸을 만나면 없는 PID
+            return -1;
+        i = (i + 1) & WORKER_INDEX_MASK;
+    }
+    return -1;
+}
+WorkerRecord *
+worker_registry_find(ServerState *state, pid_t pid)
+{
+    if (state->workers == NULL)
+        return NULL;
+    int i = worker_index_find(state->workers, pid);
+    return i < 0 ? NULL : &state->workers->table->records[state->workers->index[i].record];
+}
+int
+worker_registry_remove(ServerState *state, pid_t pid, WorkerRecord *out)
+{
+    WorkerRegistry *reg = state->workers;
+    if (reg == NULL)
+        return -1;
+    int found = worker_index_find(reg, pid);
+    if (found < 0)
+        return -1;
+    uint32_t hole = (uint32_t)found;
+    int record = reg->index[hole].record;
+    WorkerRecord *rec = &reg->table->records[record];
+    if (out != NULL)
+    {
+        out->pid = pid;
+        out->session_id = rec->session_id;
+        out->addr = rec->addr;
+        out->spawn_ms = rec->spawn_ms;
+        out->last_activity_ms = atomic_load(&rec->last_activity_ms);
+        out->activity = atomic_load(&rec->activity);
+        out->backend = rec->backend;
+        out->bytes_in = atomic_load(&rec->bytes_in);
+        out->bytes_out = atomic_load(&rec->bytes_out);
+        out->io_count = atomic_load(&rec->io_count);
+    }
+    atomic_store(&rec->pid, 0);
+    reg->free_records[reg->free_count++] = record;
+    reg->count--;
+    uint32_t j = hole;
+    for (;;)                                                                    // backward-shift 삭제: 툼스톤 없이 탐사 체인 유지
+    {
+        j = (j + 1) & WORKER_INDEX_MASK;
+        if (reg->index[j].pid == 0)
+            break;
+        uint32_t home = worker_index_home(reg->index[j].pid);
+        if (((j - home) & WORKER_INDEX_MASK) >= ((j - hole) & WORKER_INDEX_MASK))  // j의 원래 위치가 hole 이전이면 당겨옴
+        {
+            reg->index[hole] = reg->index[j];
+            hole = j;
+        }
+    }
+    reg->index[hole].pid = 0;
+    return 0;
+}
+void
+worker_registry_account(ServerState *state, size_t bytes_in, size_t bytes_out)
+{
+    WorkerRecord *rec = state->self_record;
+    if (rec == NULL)
+        return;
+    if (bytes_in)
+        atomic_fetch_add_explicit(&rec->bytes_in, bytes_in, memory_order_relaxed);   // 워커가 자기 레코드만 갱신
+    if (bytes_out)
+    {
+        atomic_fetch_add_explicit(&rec->bytes_out, bytes_out, memory_order_relaxed);
+        atomic_fetch_add_explicit(&rec->io_count, 1, memory_order_relaxed);
+    }
+    if (bytes_out && state->accept_us != 0)                                     // 세션의 첫 에코: accept부터의 지연 기록
+    {
+        uint64_t now = timer_wheel_clock_us();
+        uint64_t latency = now > state->accept_us ? now - state->accept_us : 0;
+        StartLatency *start = &state->worker_table->start[state->start_path];
+        int bucket = 0;
+        for (uint64_t v = latency; v > 1 && bucket < START_LATENCY_BUCKETS - 1; v >>= 1)   // log2(us) 구간
+            bucket++;
+        atomic_fetch_add_explicit(&start->hist[bucket], 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&start->sum_us, latency, memory_order_relaxed);
+        atomic_fetch_add_explicit(&start->count, 1, memory_order_relaxed);
+        uint64_t max = atomic_load(&start->max_us);
+        while (latency > max && !atomic_compare_exchange_weak(&start->max_us, &max, latency))
+            ;
+        state->accept_us = 0;
+    }
+}
+void
+worker_registry_session_start(ServerState *state, uint64_t accept_us, StartPath path)
+{
+    state->accept_us = state->self_record ? accept_us : 0;                      // 레지스트리 없으면 측정 생략
+    state->start_path = path;
+}
+int
+worker_registry_signal(ServerState *state, int signo)
+{
+    WorkerRegistry *reg = state->workers;
+    if (reg == NULL)
+        return 0;
+    int sent = 0;
+    for (int r = 0; r < MAX_WORKERS && sent < reg->count; r++)                 // kill(0, ...)과 달리 부모 자신은 제외
+    {
+        pid_t pid = atomic_load(&reg->table->records[r].pid);
+        if (pid != 0 && kill(pid, signo) == 0)
+            sent++;
+    }
+    return sent;
+}
+void
+worker_registry_activity(ServerState *state, WorkerActivity activity)
+{
+    WorkerRecord *rec = state->self_record;
+    if (rec == NULL)
+        return;
+    atomic_store_explicit(&rec->activity, (uint8_t)activity, memory_order_relaxed);   // 일반 store: 시스템 콜 없이 스코어보드에 노출
+    atomic_store_explicit(&rec->last_activity_ms, timer_wheel_clock_ms(), memory_order_relaxed);
+}
+static uint64_t
+worker_latency_percentile(const StartLatency *start, uint64_t count, double p)
+{
+    uint64_t target = (uint64_t)(count * p), seen = 0;
+    for (int b = 0; b < START_LATENCY_BUCKETS; b++)
+    {
+        seen += atomic_load(&start->hist[b]);
+        if (seen > target)
+            return 1ULL << (b + 1);                                             // 구간 상한 (2배 정밀도)
+    }
+    return 1ULL << START_LATENCY_BUCKETS;
+}
+void
+worker_registry_latency_report(ServerState *state)
+{
+    static const char *const path_names[START_PATHS] = {"fork+exec", "대기 Worker"};
+    WorkerRegistry *reg = state->workers;
+    if (reg == NULL)
+        return;
+    for (int p = 0; p < START_PATHS; p++)
+    {
+        const StartLatency *start = &reg->table->start[p];
+        uint64_t count = atomic_load(&start->count);
+        if (count == 0)
+            continue;
+        log_message(state, LOG_INFO, "세션 시작 지연 (accept → 첫 에코, %s): %llu건, 평균 %.1f us (p50 < %llu us, p90 < %llu us, p99 < %llu us, max %llu us)",
+                    path_names[p], (unsigned long long)count, (double)atomic_load(&start->sum_us) / count,
+                    (unsigned long long)worker_latency_percentile(start, count, 0.50),
+                    (unsigned long long)worker_latency_percentile(start, count, 0.90),
+                    (unsigned long long)worker_latency_percentile(start, count, 0.99),
+                    (unsigned long long)atomic_load(&start->max_us));
+    }
+}
+const char *
+worker_activity_name(WorkerActivity activity)
+{
+    return activity < WORKER_ACTIVITY_COUNT ? worker_activity_names[activity] : "?";
+}
+void
+worker_registry_dump(ServerState *state, LogLevel level, int limit)
+{
+    WorkerRegistry *reg = state->workers;
+    if (reg == NULL)
+        return;
+    uint64_t now = timer_wheel_clock_ms();
+    int shown = 0;
+    for (int r = 0; r < MAX_WORKERS && shown < limit && shown < reg->count; r++)
+    {
+        WorkerRecord *rec = &reg->table->records[r];
+        pid_t pid = atomic_load(&rec->pid);
+        if (pid == 0)
+            continue;
+        char ip[INET_ADDRSTRLEN];
+        inet_ntop(AF_INET, &rec->addr.sin_addr, ip, sizeof(ip));
+        log_message(state, level, "  Worker PID %d: %s (%.1f초 전), Session #%d, %s:%d, %.1f초 경과, I/O %u, in %llu / out %llu bytes",
+                    pid, worker_activity_name(atomic_load(&rec->activity)), (now - atomic_load(&rec->last_activity_ms)) / 1000.0,
+                    rec->session_id, ip, ntohs(rec->addr.sin_port), (now - rec->spawn_ms) / 1000.0,
+                    atomic_load(&rec->io_count), (unsigned long long)atomic_load(&rec->bytes_in), (unsigned long long)atomic_load(&rec->bytes_out));
+        shown++;
+    }
+    if (reg->count > shown)
+        log_message(state, level, "  ... 외 %d개", reg->count - shown);
+}